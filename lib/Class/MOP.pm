@@ -46,14 +46,91 @@ XSLoader::load( __PACKAGE__, $XS_VERSION );
     # Anonymous classes manage their own destruction.
     my %METAS;
 
+    # Short keys for classes, such as "person" for My::App::Person, as
+    # key => class name, and class name => { key => 1 }. A key goes away
+    # with the metaclass of its class.
+    my ( %KEYS, %KEYS_FOR );
+
+    # Changes to classes are numbered from here, see Class::MOP::Class's
+    # generation method. Adding or removing a metaclass takes a number too,
+    # since it changes the hierarchies the class is part of.
+    my $last_generation = 0;
+
+    sub _next_generation { ++$last_generation }
+    sub _last_generation { $last_generation }
+
     sub get_all_metaclasses         {        %METAS         }
     sub get_all_metaclass_instances { values %METAS         }
     sub get_all_metaclass_names     { keys   %METAS         }
     sub get_metaclass_by_name       { $METAS{$_[0]}         }
-    sub store_metaclass_by_name     { $METAS{$_[0]} = $_[1] }
     sub weaken_metaclass            { weaken($METAS{$_[0]}) }
     sub does_metaclass_exist        { exists $METAS{$_[0]} && defined $METAS{$_[0]} }
-    sub remove_metaclass_by_name    { delete $METAS{$_[0]}; return }
+
+    sub store_metaclass_by_name {
+        my ( $name, $meta ) = @_;
+        $METAS{$name} = $meta;
+        $last_generation++;
+        _index_methods($meta)    if $Class::MOP::METHOD_INDEX;
+        _index_attributes($meta) if $Class::MOP::ATTRIBUTE_INDEX;
+        return $meta;
+    }
+
+    sub remove_metaclass_by_name {
+        my $name = shift;
+        delete $METAS{$name};
+        $last_generation++;
+
+        if ( my $keys = delete $KEYS_FOR{$name} ) {
+            delete @KEYS{ keys %$keys };
+        }
+
+        _unindex_methods($name)    if $Class::MOP::METHOD_INDEX;
+        _unindex_attributes($name) if $Class::MOP::ATTRIBUTE_INDEX;
+        return;
+    }
+
+    sub get_metaclass_by_key {
+        my $name = $KEYS{ $_[0] };
+        return defined $name ? $METAS{$name} : undef;
+    }
+
+    sub get_metaclasses_by_keys {
+        return map { defined $_ ? $METAS{$_} : undef } @KEYS{@_};
+    }
+
+    sub get_metaclass_keys { keys %{ $KEYS_FOR{ $_[0] } || {} } }
+
+    sub store_metaclass_key {
+        my ( $key, $name ) = @_;
+
+        ( defined $key && length $key )
+            || confess "You must define a key";
+
+        ( defined $name && does_metaclass_exist($name) )
+            || confess "There is no metaclass for ("
+                . ( defined $name ? $name : 'undef' ) . ")";
+
+        my $current = $KEYS{$key};
+        ( !defined $current || $current eq $name )
+            || confess "The key ($key) is already used by ($current)";
+
+        $KEYS{$key} = $name;
+        $KEYS_FOR{$name}{$key} = 1;
+
+        return;
+    }
+
+    sub remove_metaclass_key {
+        my $key = shift;
+
+        my $name = delete $KEYS{$key};
+        return unless defined $name;
+
+        delete $KEYS_FOR{$name}{$key};
+        delete $KEYS_FOR{$name} unless %{ $KEYS_FOR{$name} };
+
+        return;
+    }
 
     # This handles instances as well as class names
     sub class_of {
@@ -69,6 +146,423 @@ XSLoader::load( __PACKAGE__, $XS_VERSION );
     # because I don't yet see a good reason to do so.
 }
 
+{
+    # method name => { class name => 1 }, for every class in the registry.
+    # It is only built the first time it's needed, and from then on kept up
+    # to date by add_method, remove_method and the registry. Subs which were
+    # put into a symbol table directly are picked up when the class's method
+    # map is next rebuilt (see _full_method_map in xs/HasMethods.xs), which
+    # reindexes the class unless the index already saw its latest change.
+    our $METHOD_INDEX;
+
+    # class name => { method name => 1 }, what is in the index for each class
+    my %indexed_methods;
+
+    # class name => the class's package generation when the index last
+    # changed for it
+    my %indexed_generations;
+
+    sub get_metaclasses_by_method_name {
+        my $method_name = shift;
+
+        ( defined $method_name && length $method_name )
+            || confess "You must define a method name";
+
+        _build_method_index() unless $METHOD_INDEX;
+
+        return grep { defined }
+            map { get_metaclass_by_name($_) }
+            keys %{ $METHOD_INDEX->{$method_name} || {} };
+    }
+
+    # called from xs/HasMethods.xs when a method map has been rebuilt
+    sub _reindex_methods {
+        my $meta = shift;
+
+        my $generation = $indexed_generations{ $meta->name };
+        return if defined $generation
+            && $generation == mro::get_pkg_gen( $meta->name );
+
+        _index_methods($meta);
+    }
+
+    sub _build_method_index {
+        $METHOD_INDEX = {};
+        _index_methods($_) for get_all_metaclass_instances();
+    }
+
+    sub _index_methods {
+        my $meta = shift;
+
+        return unless blessed($meta) && $meta->can('get_method_list');
+
+        my $class_name = $meta->name;
+        _unindex_methods($class_name);
+
+        $indexed_methods{$class_name} = {};
+        _index_method( $class_name, $_ ) for $meta->get_method_list;
+
+        $indexed_generations{$class_name} = mro::get_pkg_gen($class_name);
+    }
+
+    sub _unindex_methods {
+        my $class_name = shift;
+
+        my $method_names = $indexed_methods{$class_name}
+            or return;
+
+        _unindex_method( $class_name, $_ ) for keys %$method_names;
+        delete $indexed_methods{$class_name};
+        delete $indexed_generations{$class_name};
+    }
+
+    sub _index_method {
+        my ( $class_name, $method_name ) = @_;
+
+        # not a class in the registry (yet)
+        my $method_names = $indexed_methods{$class_name}
+            or return;
+
+        $method_names->{$method_name} = 1;
+        $METHOD_INDEX->{$method_name}{$class_name} = 1;
+
+        # the index has seen the package as it is now, so a method map
+        # rebuilt after this doesn't have to reindex the class
+        $indexed_generations{$class_name} = mro::get_pkg_gen($class_name);
+    }
+
+    sub _unindex_method {
+        my ( $class_name, $method_name ) = @_;
+
+        my $method_names = $indexed_methods{$class_name}
+            or return;
+        delete $method_names->{$method_name};
+
+        $indexed_generations{$class_name} = mro::get_pkg_gen($class_name);
+
+        my $classes = $METHOD_INDEX->{$method_name}
+            or return;
+        delete $classes->{$class_name};
+        delete $METHOD_INDEX->{$method_name} unless %$classes;
+    }
+}
+
+{
+    # attribute name => { class name => 1 }, and
+    # init_arg => { class name => attribute name }, for the attributes which
+    # each class in the registry has itself. Like the method index, this is
+    # built the first time it's needed, and then kept up to date by
+    # add_attribute, remove_attribute and the registry.
+    our $ATTRIBUTE_INDEX;
+
+    # class name => { attribute name => init_arg }, what is in the index for
+    # each class
+    my %indexed_attributes;
+
+    sub get_metaclasses_by_attribute_name {
+        my ( $attribute_name, %options ) = @_;
+
+        ( defined $attribute_name )
+            || confess "You must define an attribute name";
+
+        _build_attribute_index() unless $ATTRIBUTE_INDEX;
+
+        my @class_names
+            = keys %{ $ATTRIBUTE_INDEX->{name}{$attribute_name} || {} };
+
+        # subclasses always have the attribute, even if they have their own
+        # version of it
+        @class_names = _with_subclasses(@class_names) if $options{inherited};
+
+        return grep { defined } map { get_metaclass_by_name($_) } @class_names;
+    }
+
+    sub get_metaclasses_by_init_arg {
+        my ( $init_arg, %options ) = @_;
+
+        ( defined $init_arg )
+            || confess "You must define an init_arg";
+
+        _build_attribute_index() unless $ATTRIBUTE_INDEX;
+
+        my $attribute_names = $ATTRIBUTE_INDEX->{init_arg}{$init_arg} || {};
+        my @metaclasses = grep { defined }
+            map { get_metaclass_by_name($_) } keys %$attribute_names;
+
+        return @metaclasses unless $options{inherited};
+
+        # a subclass's own version of the attribute may not accept the
+        # init_arg any more
+        my %names = map { $_ => 1 } values %$attribute_names;
+
+        return grep {
+            my $meta = $_;
+            grep {
+                my $attr = $meta->find_attribute_by_name($_);
+                $attr && defined $attr->init_arg && $attr->init_arg eq $init_arg;
+            } keys %names;
+        } grep { defined } map { get_metaclass_by_name($_) }
+            _with_subclasses( keys %$attribute_names );
+    }
+
+    sub _with_subclasses {
+        my %seen;
+        return grep { !$seen{$_}++ }
+            map { $_, @{ mro::get_isarev($_) } } @_;
+    }
+
+    sub _build_attribute_index {
+        $ATTRIBUTE_INDEX = { name => {}, init_arg => {} };
+        _index_attributes($_) for get_all_metaclass_instances();
+    }
+
+    sub _index_attributes {
+        my $meta = shift;
+
+        return unless blessed($meta) && $meta->can('_attribute_map');
+
+        my $class_name = $meta->name;
+        _unindex_attributes($class_name);
+
+        $indexed_attributes{$class_name} = {};
+        _index_attribute( $class_name, $_ )
+            for values %{ $meta->_attribute_map || {} };
+    }
+
+    sub _unindex_attributes {
+        my $class_name = shift;
+
+        my $attributes = $indexed_attributes{$class_name}
+            or return;
+
+        _unindex_attribute( $class_name, $_ ) for keys %$attributes;
+        delete $indexed_attributes{$class_name};
+    }
+
+    sub _index_attribute {
+        my ( $class_name, $attribute ) = @_;
+
+        # not a class in the registry (yet)
+        my $attributes = $indexed_attributes{$class_name}
+            or return;
+
+        my $name     = $attribute->name;
+        my $init_arg = $attribute->init_arg;
+
+        $attributes->{$name} = $init_arg;
+        $ATTRIBUTE_INDEX->{name}{$name}{$class_name} = 1;
+        $ATTRIBUTE_INDEX->{init_arg}{$init_arg}{$class_name} = $name
+            if defined $init_arg;
+    }
+
+    sub _unindex_attribute {
+        my ( $class_name, $name ) = @_;
+
+        my $attributes = $indexed_attributes{$class_name}
+            or return;
+        return unless exists $attributes->{$name};
+
+        my $init_arg = delete $attributes->{$name};
+
+        for my $index (
+            [ name => $name ],
+            ( defined $init_arg ? [ init_arg => $init_arg ] : () )
+            ) {
+            my ( $kind, $key ) = @$index;
+            my $classes = $ATTRIBUTE_INDEX->{$kind}{$key}
+                or next;
+            delete $classes->{$class_name};
+            delete $ATTRIBUTE_INDEX->{$kind}{$key} unless %$classes;
+        }
+    }
+}
+
+{
+    # Listeners for changes to metaclasses, by event. An event with no
+    # listeners has no entry here, so the places which make changes only
+    # pay for one hash lookup when nobody is listening.
+    our %LISTENERS;
+
+    my %EVENTS = map { $_ => 1 } qw(
+        method_added
+        method_removed
+        attribute_added
+        attribute_removed
+        superclasses_changed
+        made_immutable
+        made_mutable
+    );
+
+    sub add_metaclass_listener {
+        my ( $event, $listener ) = @_;
+
+        ( defined $event && $EVENTS{$event} )
+            || confess "Unknown metaclass event ("
+                . ( defined $event ? $event : 'undef' ) . ")";
+        ( ref $listener eq 'CODE' )
+            || confess "You must pass a CODE reference as the listener";
+
+        push @{ $LISTENERS{$event} }, $listener;
+
+        return $listener;
+    }
+
+    sub remove_metaclass_listener {
+        my ( $event, $listener ) = @_;
+
+        my $listeners = $LISTENERS{$event}
+            or return;
+
+        $LISTENERS{$event} = [ grep { $_ != $listener } @$listeners ];
+        delete $LISTENERS{$event} unless @{ $LISTENERS{$event} };
+
+        return;
+    }
+
+    sub _notify_listeners {
+        my ( $event, $metaclass, @args ) = @_;
+
+        # listeners may remove themselves, which replaces the list
+        $_->( $metaclass, $event, @args ) for @{ $LISTENERS{$event} || [] };
+    }
+}
+
+{
+    # While a batch_define block runs, the work which superclasses() and
+    # invalidate_meta_instances() would normally do right away is queued in
+    # here, once per class, and done when the outermost block ends. So is
+    # removing the packages of anon classes which go away.
+    our $DEFERRED;
+
+    sub batch_define (&) {
+        my $code = shift;
+
+        # a nested batch is part of the outer one
+        return $code->() if $DEFERRED;
+
+        my $batch = {
+            order         => [],
+            checks        => {},
+            invalidate    => {},
+            anon_packages => [],
+        };
+        my $want  = wantarray;
+        my ( @result, $error, $failed );
+        {
+            local $DEFERRED = $batch;
+            try {
+                @result = $want ? $code->() : scalar $code->();
+            }
+            catch {
+                ( $error, $failed ) = ( $_, 1 );
+            };
+        }
+
+        # if the block died, the classes may be half defined, so only make
+        # sure that no stale meta instances are left behind
+        my @errors = _run_deferred_checks( $batch, !$failed );
+        ( $error, $failed ) = ( $errors[0], 1 ) if !$failed && @errors;
+
+        $batch->{remove_anon_packages}->( @{ $batch->{anon_packages} } )
+            if @{ $batch->{anon_packages} };
+
+        die $error if $failed;
+
+        return $want ? @result : $result[0];
+    }
+
+    sub _defer_check {
+        my ( $metaclass, $check ) = @_;
+
+        my $batch = $DEFERRED
+            or return;
+
+        my $name = $metaclass->name;
+        my $checks = $batch->{checks}{$name} ||= do {
+            push @{ $batch->{order} }, $name;
+            {};
+        };
+
+        # weak, so that anon classes can still go away inside the block
+        $checks->{metaclass} = $metaclass;
+        $checks->{$check}    = 1;
+        weaken $checks->{metaclass};
+
+        if ( $check eq 'invalidate_meta_instances' ) {
+            $batch->{invalidate}{$name} = $metaclass;
+            weaken $batch->{invalidate}{$name};
+        }
+
+        return 1;
+    }
+
+    sub _defer_anon_package_removal {
+        my ( $serial_id, $remover ) = @_;
+
+        my $batch = $DEFERRED
+            or return;
+
+        push @{ $batch->{anon_packages} }, $serial_id;
+        $batch->{remove_anon_packages} = $remover;
+
+        return 1;
+    }
+
+    # meta instances can be needed in the middle of a batch too, so this
+    # runs the invalidations which have been queued so far
+    sub _run_deferred_invalidations {
+        my $batch = $DEFERRED
+            or return;
+
+        return unless %{ $batch->{invalidate} };
+
+        my @names = keys %{ $batch->{invalidate} };
+        my @metaclasses = grep {defined} values %{ $batch->{invalidate} };
+        %{ $batch->{invalidate} } = ();
+        delete $batch->{checks}{$_}{invalidate_meta_instances} for @names;
+
+        local $DEFERRED;
+        $_->invalidate_meta_instances for @metaclasses;
+    }
+
+    # Returns what the checks died with. Once one has died, the rest are
+    # skipped, as they would have been outside of a batch, but every class
+    # still has its meta instances invalidated.
+    sub _run_deferred_checks {
+        my ( $batch, $validate ) = @_;
+
+        my @errors;
+        for my $name ( @{ $batch->{order} } ) {
+            my $checks = $batch->{checks}{$name};
+            my $meta   = $checks->{metaclass}
+                or next;
+
+            if ( $validate && !@errors ) {
+                try {
+                    $name->isa($name) if $checks->{superclasses};
+                    $meta->_check_metaclass_compatibility
+                        if $checks->{superclasses}
+                            || $checks->{metaclass_compatibility};
+                    $meta->_superclasses_updated if $checks->{superclasses};
+                }
+                catch {
+                    push @errors, $_;
+                };
+            }
+
+            try {
+                $meta->invalidate_meta_instances
+                    if $checks->{invalidate_meta_instances};
+            }
+            catch {
+                push @errors, $_;
+            };
+        }
+
+        return @errors;
+    }
+}
+
 sub _class_to_pmfile {
     my $class = shift;
 
@@ -984,6 +1478,103 @@ is from and the name of the C<$code> itself. This is used by several
 elements of the MOP to determine where a given C<$code> reference is
 from.
 
+=item B<Class::MOP::get_code_info_list(\@codes)>
+
+This is a batch version of C<get_code_info>. It takes an array
+reference of code references and returns a flat list with two values,
+the package name and the sub name, for each element. Both values are
+C<undef> for elements which are not named code references.
+
+  my @info = Class::MOP::get_code_info_list(\@codes);
+  while ( my ( $pkg, $name ) = splice @info, 0, 2 ) {
+      ...
+  }
+
+This is much cheaper than calling C<get_code_info> in a loop when
+examining many subroutines at once.
+
+=item B<Class::MOP::batch_define { ... }>
+
+This runs the block, and postpones some of the work that defining
+classes usually does until the block ends. That work is done once for
+each class, however many changes were made to it inside the block.
+
+Specifically, creating a metaclass normally checks metaclass
+compatibility, and setting C<superclasses> checks the hierarchy for
+cycles, checks metaclass compatibility, and updates the meta instance
+dependencies. Adding or removing an attribute normally invalidates the
+meta instances of the class and of its dependents. Inside the block,
+these only happen at the end. Meta instances are still brought up to
+date when one is asked for in the middle of the block.
+
+  Class::MOP::batch_define {
+      for my $spec (@specs) {
+          my $class = Class::MOP::Class->create( $spec->{name} );
+          $class->superclasses( @{ $spec->{superclasses} } );
+          $class->add_attribute($_) for @{ $spec->{attributes} };
+      }
+  };
+
+Anonymous classes which go away inside the block have their packages
+removed after it ends, subclasses first, rather than while the block is
+running. This moves the work out of the block, but doesn't make it any
+less: each package is still removed on its own.
+
+Nested calls are part of the outermost one. The block's return value is
+returned. If the block dies, the postponed meta instance invalidations
+are still done, the checks are skipped, and the exception is rethrown.
+If one of the postponed checks dies, the checks after it are skipped,
+but the invalidations and package removals are still done before its
+exception is rethrown.
+
+=item B<Class::MOP::add_metaclass_listener($event, $listener)>
+
+This registers a code reference which is called whenever a metaclass
+changes in the way C<$event> describes. Listeners are called after the
+change has been made, with the metaclass, the event name, and anything
+else the event passes along:
+
+=over 8
+
+=item * method_added
+
+A method was added. The method's name is passed.
+
+=item * method_removed
+
+A method was removed. The method's name is passed.
+
+=item * attribute_added
+
+An attribute was added. The attribute is passed.
+
+=item * attribute_removed
+
+An attribute was removed. The attribute is passed.
+
+=item * superclasses_changed
+
+The superclasses were set.
+
+=item * made_immutable
+
+=item * made_mutable
+
+The class was made immutable or mutable.
+
+=back
+
+Changes which are made without going through the MOP, such as defining a
+sub or assigning to C<@ISA> directly, are not reported. Events with no
+listeners cost next to nothing.
+
+The listener is returned, so that it can be passed to
+C<remove_metaclass_listener> later.
+
+=item B<Class::MOP::remove_metaclass_listener($event, $listener)>
+
+This unregisters a listener.
+
 =item B<Class::MOP::class_of($instance_or_class_name)>
 
 This will return the metaclass of the given instance or class name.  If the
@@ -1069,7 +1660,71 @@ C<$name> key, and return false otherwise.
 
 =item B<Class::MOP::remove_metaclass_by_name($name)>
 
-This will remove the metaclass stored in the C<$name> key.
+This will remove the metaclass stored in the C<$name> key, along with
+any keys which refer to it.
+
+=item B<Class::MOP::store_metaclass_key($key, $name)>
+
+This gives the metaclass stored under C<$name> a short key, such as
+C<person> for C<My::App::Person>, which can be used to look it up with
+C<get_metaclass_by_key>. A class may have more than one key, but a key
+can only belong to one class, and it is an error to reuse one. There
+must already be a metaclass stored under C<$name>.
+
+Keys are removed along with the metaclass, except by C<reinitialize>,
+which gives the new metaclass the old one's keys.
+
+=item B<Class::MOP::remove_metaclass_key($key)>
+
+This removes a key.
+
+=item B<Class::MOP::get_metaclass_by_key($key)>
+
+This returns the metaclass with the given key, or undef.
+
+=item B<Class::MOP::get_metaclasses_by_keys(@keys)>
+
+This looks up many keys at once, and returns a list with a metaclass, or
+undef, for each of them.
+
+=item B<Class::MOP::get_metaclass_keys($name)>
+
+This returns the keys of the metaclass stored under C<$name>.
+
+=item B<Class::MOP::get_metaclasses_by_method_name($method_name)>
+
+This returns the metaclasses in the cache whose classes have a method
+named C<$method_name> (as in C<< $metaclass->has_method >>, so inherited
+methods don't count).
+
+The answer comes from an index of method names. The index is built the
+first time this function is called, and is then kept up to date as
+methods are added and removed through the MOP, and as metaclasses are
+stored and removed. Looking a name up does not look at any class.
+
+This means that it only sees changes made through the MOP. Subs which
+are put into (or deleted from) a package's symbol table directly are
+picked up when the class's full method map is next rebuilt, which
+C<remove_method> and C<get_method_map> do once the package has
+changed, or when its metaclass is stored again.
+
+=item B<Class::MOP::get_metaclasses_by_attribute_name($attribute_name, %options)>
+
+This returns the metaclasses in the cache whose classes have an
+attribute named C<$attribute_name> themselves. If the C<inherited>
+option is true, metaclasses of subclasses which inherit the attribute
+are returned too.
+
+Like the method index, the attribute index is built the first time it
+is needed, and kept up to date as attributes are added and removed, and
+as metaclasses are stored and removed.
+
+=item B<Class::MOP::get_metaclasses_by_init_arg($init_arg, %options)>
+
+This returns the metaclasses in the cache whose classes have an
+attribute which takes C<$init_arg> as its constructor parameter. It
+accepts the same C<inherited> option. A subclass is only returned if the
+attribute it ends up with still takes C<$init_arg>.
 
 =back
 
@@ -156,6 +156,92 @@ sub _set_initial_slot_value {
     $instance->$initializer($value, $callback, $self);
 }
 
+# Returns a closure which does what initialize_instance_slot does for this
+# attribute, without the method calls. It is what Class::MOP::Class builds
+# its construction plan from. Attributes which change how their slot gets
+# initialized just get a closure which calls initialize_instance_slot.
+sub _construction_step {
+    my ($self, $meta_instance) = @_;
+
+    if ( $self->has_initializer
+        || grep { $self->can($_) != Class::MOP::Attribute->can($_) }
+        qw( initialize_instance_slot _set_initial_slot_value default ) ) {
+        return sub { $self->initialize_instance_slot( $meta_instance, @_ ) };
+    }
+
+    my $slot_name       = $self->name;
+    my $init_arg        = $self->{'init_arg'};
+    my $default         = $self->{'default'};
+    my $default_is_code = $self->is_default_a_coderef;
+    my $builder         = $self->{'builder'};
+
+    # the common case is a plain hash based instance
+    my $direct = $meta_instance->can('set_slot_value')
+        == Class::MOP::Instance->can('set_slot_value');
+
+    return sub {
+        my ($instance, $params) = @_;
+        my $value;
+
+        if (defined $init_arg and exists $params->{$init_arg}) {
+            $value = $params->{$init_arg};
+        }
+        elsif (defined $default) {
+            $value = $default_is_code ? $default->($instance) : $default;
+        }
+        elsif (defined $builder) {
+            my $method = $instance->can($builder)
+                || confess(ref($instance)." does not support builder method '". $builder ."' for attribute '" . $slot_name . "'");
+            $value = $instance->$method;
+        }
+        else {
+            return;
+        }
+
+        $direct
+            ? ( $instance->{$slot_name} = $value )
+            : $meta_instance->set_slot_value($instance, $slot_name, $value);
+    };
+}
+
+# The part of rebless_instance which carries an existing value over, either
+# into the constructor parameters or back into its slot. Returns nothing if
+# there is nothing to do.
+sub _rebless_step {
+    my ($self, $meta_instance) = @_;
+
+    my $slot_name = $self->name;
+    my $init_arg  = $self->init_arg;
+
+    if ( !grep { $self->can($_) != Class::MOP::Attribute->can($_) }
+            qw( has_value get_value get_raw_value set_value set_raw_value )
+        and !grep { $meta_instance->can($_) != Class::MOP::Instance->can($_) }
+            qw( is_slot_initialized get_slot_value set_slot_value ) ) {
+        # copying a hash slot onto itself does nothing
+        return unless defined $init_arg;
+
+        return sub {
+            my ($instance, $params) = @_;
+            $params->{$init_arg} = $instance->{$slot_name}
+                if exists $instance->{$slot_name}
+                && !exists $params->{$init_arg};
+        };
+    }
+
+    return sub {
+        my ($instance, $params) = @_;
+        return unless $self->has_value($instance);
+
+        if (defined $init_arg) {
+            $params->{$init_arg} = $self->get_value($instance)
+                unless exists $params->{$init_arg};
+        }
+        else {
+            $self->set_value($instance, $self->get_value($instance));
+        }
+    };
+}
+
 sub associated_class   { $_[0]->{'associated_class'}   }
 sub associated_methods { $_[0]->{'associated_methods'} }
 
@@ -10,7 +10,7 @@ use Class::MOP::Method::Accessor;
 use Class::MOP::Method::Constructor;
 
 use Carp         'confess';
-use Scalar::Util 'blessed', 'reftype', 'weaken';
+use Scalar::Util 'blessed', 'reftype', 'weaken', 'refaddr';
 use Sub::Name    'subname';
 use Devel::GlobalDestruction 'in_global_destruction';
 use Try::Tiny;
@@ -24,6 +24,13 @@ use base 'Class::MOP::Module',
          'Class::MOP::Mixin::HasAttributes',
          'Class::MOP::Mixin::HasMethods';
 
+# NOTE:
+# we need a sufficiently annoying prefix
+# this should suffice for now, this is
+# used in a couple of places below, so
+# need to put it up here for now.
+my $ANON_CLASS_PREFIX = 'Class::MOP::Class::__ANON__::SERIAL::';
+
 # Creation
 
 sub initialize {
@@ -85,11 +92,23 @@ sub _construct_class_instance {
         $meta = $class->meta->_construct_instance($options)
     }
 
+    # NOTE:
+    # the name of a class never changes, so
+    # whether it is anonymous is worked out
+    # once, here
+    $meta->{_is_anon_class}
+        = index( $package_name, $ANON_CLASS_PREFIX ) == 0 ? 1 : 0;
+
     # and check the metaclass compatibility
-    $meta->_check_metaclass_compatibility();  
+    # (at the end of Class::MOP::batch_define, if we are in one)
+    $meta->_check_metaclass_compatibility()
+        unless Class::MOP::_defer_check( $meta, 'metaclass_compatibility' );
 
     Class::MOP::store_metaclass_by_name($package_name, $meta);
 
+    # a new metaclass is a change too, since it may replace an old one
+    $meta->_increment_generation;
+
     # NOTE:
     # we need to weaken any anon classes
     # so that they can call DESTROY properly
@@ -187,10 +206,56 @@ sub update_package_cache_flag {
     sub _base_metaclasses { %base_metaclass }
 }
 
-sub _check_metaclass_compatibility {
+{
+    # Signatures of metaclass setups which have been checked, and found to be
+    # compatible without needing to be fixed. Another class with the same
+    # setup doesn't need to be checked again.
+    my %compatible_signatures;
+
+    # The class metaclass and the metaclass of each kind, read straight from
+    # the slots. This is everything the compatibility check looks at.
+    my $setup_of = sub {
+        my ($meta, $class_metaclass, $types) = @_;
+        no warnings 'uninitialized';
+        return join ',', $class_metaclass, @{$meta}{@$types};
+    };
+
+    sub _check_metaclass_compatibility {
+        my $self = shift;
+
+        my @superclasses = $self->superclasses
+            or return;
+
+        my @types = sort keys %{ { $self->_base_metaclasses } };
+
+        my @super_metas
+            = map { Class::MOP::get_metaclass_by_name($_) } @superclasses;
+
+        # the check creates the missing metaclasses, so this setup won't
+        # come up again
+        if ( grep { !defined } @super_metas ) {
+            return $self->_check_metaclass_compatibility_uncached(@superclasses);
+        }
+
+        my $own       = $setup_of->($self, ref $self, \@types);
+        my $signature = join "\0", $own,
+            map { $setup_of->($_, $_->_real_ref_name, \@types) } @super_metas;
+
+        return if $compatible_signatures{$signature};
+
+        $self->_check_metaclass_compatibility_uncached(@superclasses);
+
+        # fixing only changes this class's metaclasses. If something got
+        # fixed, the next class with this setup needs fixing too
+        $compatible_signatures{$signature} = 1
+            if $own eq $setup_of->($self, ref $self, \@types);
+    }
+}
+
+sub _check_metaclass_compatibility_uncached {
     my $self = shift;
 
-    if (my @superclasses = $self->superclasses) {
+    if (my @superclasses = @_) {
         $self->_fix_metaclass_incompatibility(@superclasses);
 
         my %base_metaclass = $self->_base_metaclasses;
@@ -393,6 +458,10 @@ sub _fix_single_metaclass_incompatibility {
 
 ## ANON classes
 
+# These are set up with the inheritance caches further down, and called
+# when an anon class goes away.
+my ( $unindex_superclasses, $forget_precedence_list );
+
 {
     # NOTE:
     # this should be sufficient, if you have a
@@ -401,24 +470,114 @@ sub _fix_single_metaclass_incompatibility {
     my $ANON_CLASS_SERIAL = 0;
 
     # NOTE:
-    # we need a sufficiently annoying prefix
-    # this should suffice for now, this is
-    # used in a couple of places below, so
-    # need to put it up here for now.
-    my $ANON_CLASS_PREFIX = 'Class::MOP::Class::__ANON__::SERIAL::';
-
+    # _construct_class_instance records this
+    # for every metaclass it creates, so the
+    # name is only looked at for metaclasses
+    # which were built some other way
     sub is_anon_class {
         my $self = shift;
+        return $self->{_is_anon_class} if exists $self->{_is_anon_class};
         no warnings 'uninitialized';
-        $self->name =~ /^$ANON_CLASS_PREFIX/o;
+        $self->name =~ /^$ANON_CLASS_PREFIX/o ? 1 : 0;
     }
 
+    # NOTE:
+    # anon classes created with the cache
+    # option, keyed by their signature. Like
+    # the metaclass registry, this only holds
+    # weak references, so a cached class still
+    # goes away once nothing uses it.
+    my %ANON_CLASS_CACHE;
+
     sub create_anon_class {
         my ($class, %options) = @_;
+
+        my $cache_key;
+        if (delete $options{cache}) {
+            $cache_key = $class->_anon_class_cache_key(%options);
+
+            my $meta = $ANON_CLASS_CACHE{$cache_key};
+            return $meta
+                if defined $meta
+                && Class::MOP::get_metaclass_by_name($meta->name) == $meta;
+        }
+
         my $package_name = $ANON_CLASS_PREFIX . ++$ANON_CLASS_SERIAL;
-        return $class->create($package_name, %options);
+        my $meta = $class->create($package_name, %options);
+
+        if (defined $cache_key) {
+            $meta->{_anon_class_cache_key} = $cache_key;
+            $ANON_CLASS_CACHE{$cache_key} = $meta;
+            weaken $ANON_CLASS_CACHE{$cache_key};
+        }
+
+        return $meta;
+    }
+
+    # Code and other references are identified by their address. They
+    # belong to the cached class, so the address can't be reused by
+    # something else while the class is alive.
+    my $describe;
+    $describe = sub {
+        my $value = shift;
+
+        return 'undef' unless defined $value;
+        return 'string:' . $value unless ref $value;
+        return 'ref:' . refaddr($value)
+            if blessed($value) || reftype($value) !~ /^(?:ARRAY|HASH)$/;
+
+        return '[' . join( ',', map { $describe->($_) } @$value ) . ']'
+            if reftype($value) eq 'ARRAY';
+
+        return '{'
+            . join( ',',
+            map { $describe->($_) . '=>' . $describe->( $value->{$_} ) }
+                sort keys %$value )
+            . '}';
+    };
+
+    sub _anon_class_cache_key {
+        my ($class, %options) = @_;
+
+        my $attributes = delete $options{attributes} || [];
+        my $methods    = delete $options{methods}    || {};
+
+        return join "\0",
+            ( ref($class) || $class ),
+            $describe->( \%options ),
+            (
+                map {
+                    my %attr = %$_;
+                    delete @attr{qw(
+                        associated_class
+                        associated_methods
+                        insertion_order
+                    )};
+                    ref($_) . $describe->( \%attr );
+                } @$attributes
+            ),
+            (
+                map {
+                    my $body = $methods->{$_};
+                    $body = $body->body
+                        if blessed $body && $body->isa('Class::MOP::Method');
+                    $_ . '=>' . $describe->($body);
+                } sort keys %$methods
+            );
     }
 
+    # Empties the @ISA of each package before any of them is wiped out,
+    # newest first, since later anon classes are usually the subclasses of
+    # earlier ones. Perl updates the MRO data once for every @ISA.
+    my $remove_anon_packages = sub {
+        my @serial_ids = sort { $b <=> $a } @_;
+
+        no strict 'refs';
+        @{ $ANON_CLASS_PREFIX . $_ . '::ISA' } = () for @serial_ids;
+        %{ $ANON_CLASS_PREFIX . $_ . '::' }    = () for @serial_ids;
+        delete @{$ANON_CLASS_PREFIX}{ map { $_ . '::' } @serial_ids };
+    };
+
     # NOTE:
     # this will only get called for
     # anon-classes, all other calls
@@ -430,25 +589,34 @@ sub _fix_single_metaclass_incompatibility {
 
         return if in_global_destruction(); # it'll happen soon anyway and this just makes things more complicated
 
-        no warnings 'uninitialized';
-        my $name = $self->name;
-        return unless $name =~ /^$ANON_CLASS_PREFIX/o;
+        return unless $self->is_anon_class;
 
         # Moose does a weird thing where it replaces the metaclass for
         # class when fixing metaclass incompatibility. In that case,
         # we don't want to clean out the namespace now. We can detect
         # that because Moose will explicitly update the singleton
         # cache in Class::MOP.
+        no warnings 'uninitialized';
+        my $name = $self->name;
         my $current_meta = Class::MOP::get_metaclass_by_name($name);
         return if $current_meta ne $self;
 
-        my ($serial_id) = ($name =~ /^$ANON_CLASS_PREFIX(\d+)/o);
-        no strict 'refs';
-        @{$name . '::ISA'} = ();
-        %{$name . '::'}    = ();
-        delete ${$ANON_CLASS_PREFIX}{$serial_id . '::'};
+        # inside Class::MOP::batch_define, the
+        # packages are removed at the end
+        my $serial_id = substr $name, length $ANON_CLASS_PREFIX;
+        $remove_anon_packages->($serial_id)
+            unless Class::MOP::_defer_anon_package_removal( $serial_id,
+                $remove_anon_packages );
 
         Class::MOP::remove_metaclass_by_name($name);
+        $unindex_superclasses->($name);
+        $forget_precedence_list->($name);
+
+        if (defined(my $cache_key = $self->{_anon_class_cache_key})) {
+            my $cached = $ANON_CLASS_CACHE{$cache_key};
+            delete $ANON_CLASS_CACHE{$cache_key}
+                if !defined $cached || $cached == $self;
+        }
     }
 
 }
@@ -563,9 +731,8 @@ sub _construct_instance {
     else {
         $instance = $meta_instance->create_instance();
     }
-    foreach my $attr ($class->get_all_attributes()) {
-        $attr->initialize_instance_slot($meta_instance, $instance, $params);
-    }
+    $_->($instance, $params)
+        for @{ $class->_construction_plan($meta_instance) };
     # NOTE:
     # this will only work for a HASH instance type
     if ($class->is_anon_class) {
@@ -582,8 +749,31 @@ sub _construct_instance {
 }
 
 
+# The construction plan is a list of closures, one per attribute, which
+# initialize a new instance's slots (see
+# Class::MOP::Attribute::_construction_step). Like the get_all_attributes
+# cache, it is kept for one hierarchy generation. Throwing away the meta
+# instance moves that on too.
+sub _construction_plan {
+    my ($self, $meta_instance) = @_;
+
+    my $plan = $self->{_construction_plan};
+    return $plan->{steps}
+        if $plan && $plan->{generation} == $self->hierarchy_generation;
+
+    my @attrs = $self->get_all_attributes;
+
+    $plan = $self->{_construction_plan} = {
+        generation => $self->hierarchy_generation,
+        steps => [ map { $_->_construction_step($meta_instance) } @attrs ],
+    };
+
+    return $plan->{steps};
+}
+
 sub get_meta_instance {
     my $self = shift;
+    Class::MOP::_run_deferred_invalidations() if $Class::MOP::DEFERRED;
     $self->{'_meta_instance'} ||= $self->_create_meta_instance();
 }
 
@@ -640,34 +830,72 @@ sub rebless_instance {
     $self->name->isa($old_class)
         || confess "You may rebless only into a subclass of ($old_class), of which (". $self->name .") isn't.";
 
-    $old_metaclass->rebless_instance_away($instance, $self, %params)
-        if $old_metaclass;
-
-    my $meta_instance = $self->get_meta_instance();
-
-    # rebless!
     # we use $_[1] here because of t/306_rebless_overload.t regressions on 5.8.8
-    $meta_instance->rebless_instance_structure($_[1], $self);
-
-    foreach my $attr ( $self->get_all_attributes ) {
-        if ( $attr->has_value($instance) ) {
-            if ( defined( my $init_arg = $attr->init_arg ) ) {
-                $params{$init_arg} = $attr->get_value($instance)
-                    unless exists $params{$init_arg};
-            } 
-            else {
-                $attr->set_value($instance, $attr->get_value($instance));
-            }
-        }
-    }
+    $self->_reblesser($old_class, $old_metaclass)
+         ->($self, $_[1], $old_metaclass, \%params);
 
-    foreach my $attr ($self->get_all_attributes) {
-        $attr->initialize_instance_slot($meta_instance, $instance, \%params);
-    }
-    
     $instance;
 }
 
+# A reblesser moves an instance of one class into this class. There is one
+# for each class we rebless from, and like the construction plan, it is
+# rebuilt whenever the attributes or the meta instance change.
+sub _reblesser {
+    my ($self, $old_class, $old_metaclass) = @_;
+
+    my $meta_instance = $self->get_meta_instance;
+    my $steps         = $self->_construction_plan($meta_instance);
+    my $reblessers    = $self->{_reblessers} ||= {};
+
+    my $reblesser = $reblessers->{$old_class};
+    return $reblesser->{code}
+        if $reblesser
+        && $reblesser->{steps} == $steps
+        && ( refaddr($reblesser->{old_metaclass}) || 0 )
+            == ( refaddr($old_metaclass) || 0 );
+
+    # forget about anon classes which have gone away
+    delete @{$reblessers}{
+        grep {
+            $reblessers->{$_}{had_metaclass}
+                && !$reblessers->{$_}{old_metaclass}
+        } keys %$reblessers
+    };
+
+    my $class_name = $self->name;
+
+    my $rebless_away = $old_metaclass
+        && $old_metaclass->can('rebless_instance_away')
+            != Class::MOP::Class->can('rebless_instance_away');
+    my $direct = $meta_instance->can('rebless_instance_structure')
+        == Class::MOP::Instance->can('rebless_instance_structure');
+
+    my @copy = grep { defined }
+        map { $_->_rebless_step($meta_instance) } $self->get_all_attributes;
+
+    $reblesser = $reblessers->{$old_class} = {
+        steps         => $steps,
+        old_metaclass => $old_metaclass,
+        had_metaclass => !!$old_metaclass,
+        code          => sub {
+            my ($self, $instance, $old_metaclass, $params) = @_;
+
+            $old_metaclass->rebless_instance_away($instance, $self, %$params)
+                if $rebless_away && $old_metaclass;
+
+            # we use $_[1] here because of t/306_rebless_overload.t regressions on 5.8.8
+            $direct
+                ? bless($_[1], $class_name)
+                : $meta_instance->rebless_instance_structure($_[1], $self);
+
+            $_->($instance, $params) for @copy, @$steps;
+        },
+    };
+    weaken $reblesser->{old_metaclass} if $old_metaclass;
+
+    return $reblesser->{code};
+}
+
 sub rebless_instance_back {
     my ( $self, $instance ) = @_;
 
@@ -749,40 +977,149 @@ sub find_attribute_by_name {
     return;
 }
 
+# The cached attribute list is only valid for the hierarchy generation it
+# was built in, which changes whenever a class in the hierarchy gains or
+# loses an attribute, or has its metaclass replaced.
 sub get_all_attributes {
     my $self = shift;
-    my %attrs = map { %{ Class::MOP::Class->initialize($_)->_attribute_map } }
-        reverse $self->linearized_isa;
-    return values %attrs;
+
+    my $cache = $self->{_all_attributes};
+
+    unless ( $cache
+        && $cache->{generation} == $self->hierarchy_generation ) {
+        my %attrs
+            = map { %{ Class::MOP::Class->initialize($_)->_attribute_map } }
+            reverse $self->linearized_isa;
+
+        # initialize may have created metaclasses, which moves the
+        # hierarchy generation on
+        $cache = $self->{_all_attributes} = {
+            generation => $self->hierarchy_generation,
+            attributes => [ values %attrs ],
+        };
+    }
+
+    return @{ $cache->{attributes} };
 }
 
 # Inheritance
 
-sub superclasses {
-    my $self     = shift;
-    my $var_spec = { sigil => '@', type => 'ARRAY', name => 'ISA' };
-    if (@_) {
-        my @supers = @_;
-        @{$self->get_package_symbol($var_spec)} = @supers;
+{
+    # class name => { superclasses => [...], generation => ... }, and the
+    # reverse of that, superclass name => { class name => 1 }
+    #
+    # superclasses() keeps this up to date. Classes whose @ISA is changed
+    # outside of the MOP are found through the superclass's isarev, which
+    # Perl keeps for us, whenever the number of classes in it changes. A
+    # class which is already in the index is reindexed once its package
+    # generation changes.
+    my %superclass_index;
+    my %direct_subclass_index;
+    my %isarev_size;
+
+    my $index_superclasses = sub {
+        my $class = shift;
+
+        if ( my $old = $superclass_index{$class} ) {
+            delete $direct_subclass_index{$_}{$class}
+                for @{ $old->{superclasses} };
+        }
 
-        # NOTE:
-        # on 5.8 and below, we need to call
-        # a method to get Perl to detect
-        # a cycle in the class hierarchy
-        my $class = $self->name;
-        $class->isa($class);
+        my @supers = do { no strict 'refs'; @{ $class . '::ISA' } };
+        $direct_subclass_index{$_}{$class} = 1 for @supers;
 
-        # NOTE:
-        # we need to check the metaclass
-        # compatibility here so that we can
-        # be sure that the superclass is
-        # not potentially creating an issues
-        # we don't know about
-
-        $self->_check_metaclass_compatibility();
-        $self->_superclasses_updated();
+        $superclass_index{$class} = {
+            superclasses => \@supers,
+            generation   => mro::get_pkg_gen($class),
+        };
+    };
+
+    $unindex_superclasses = sub {
+        my $class = shift;
+
+        if ( my $old = delete $superclass_index{$class} ) {
+            delete $direct_subclass_index{$_}{$class}
+                for @{ $old->{superclasses} };
+        }
+
+        delete $direct_subclass_index{$class};
+        delete $isarev_size{$class};
+    };
+
+    sub superclasses {
+        my $self     = shift;
+        my $var_spec = { sigil => '@', type => 'ARRAY', name => 'ISA' };
+        if (@_) {
+            my @supers = @_;
+            @{$self->get_package_symbol($var_spec)} = @supers;
+
+            my $class = $self->name;
+
+            $index_superclasses->($class);
+
+            # inside Class::MOP::batch_define, the
+            # checks below run once, at the end
+            unless ( Class::MOP::_defer_check( $self, 'superclasses' ) ) {
+                # NOTE:
+                # on 5.8 and below, we need to call
+                # a method to get Perl to detect
+                # a cycle in the class hierarchy
+                $class->isa($class);
+
+                # NOTE:
+                # we need to check the metaclass
+                # compatibility here so that we can
+                # be sure that the superclass is
+                # not potentially creating an issues
+                # we don't know about
+
+                $self->_check_metaclass_compatibility();
+                $self->_superclasses_updated();
+            }
+
+            $self->_increment_generation;
+
+            Class::MOP::_notify_listeners( superclasses_changed => $self )
+                if $Class::MOP::LISTENERS{superclasses_changed};
+        }
+        @{$self->get_package_symbol($var_spec)};
+    }
+
+    sub direct_subclasses {
+        my $self = shift;
+        my $name = $self->name;
+
+        my $isarev = mro::get_isarev($name);
+        if ( ( $isarev_size{$name} || 0 ) != @$isarev ) {
+            $isarev_size{$name} = @$isarev;
+            for my $class (@$isarev) {
+                my $indexed = $superclass_index{$class};
+                $index_superclasses->($class)
+                    unless $indexed
+                        && $indexed->{generation} == mro::get_pkg_gen($class);
+            }
+        }
+
+        my $direct = $direct_subclass_index{$name}
+            or return;
+
+        # only the classes indexed as direct subclasses need checking,
+        # and the ones which went away or changed their @ISA are
+        # reindexed (or dropped) here
+        for my $class ( keys %$direct ) {
+            my $generation = mro::get_pkg_gen($class);
+            next if $generation == $superclass_index{$class}{generation};
+
+            if ($generation) {
+                $index_superclasses->($class);
+            }
+            else {
+                $unindex_superclasses->($class);
+            }
+        }
+
+        return keys %$direct;
     }
-    @{$self->get_package_symbol($var_spec)};
 }
 
 sub _superclasses_updated {
@@ -797,52 +1134,75 @@ sub subclasses {
     return @{ $super_class->mro::get_isarev() };
 }
 
-sub direct_subclasses {
-    my $self = shift;
-    my $super_class = $self->name;
-
-    return grep {
-        grep {
-            $_ eq $super_class
-        } Class::MOP::Class->initialize($_)->superclasses
-    } $self->subclasses;
-}
-
 sub linearized_isa {
     return @{ mro::get_linear_isa( (shift)->name ) };
 }
 
-sub class_precedence_list {
-    my $self = shift;
-    my $name = $self->name;
+{
+    # class name => { stamp => ..., list => [ ... ] }
+    #
+    # The stamp records the package generation and mro of every class in the
+    # hierarchy, so an @ISA (or mro) change anywhere above the class makes
+    # the cached list stale.
+    my %precedence_lists;
+
+    my $hierarchy_stamp = sub {
+        my $name = shift;
+        return join ',', map { $_ . '=' . mro::get_pkg_gen($_) . mro::get_mro($_) }
+            @{ mro::get_linear_isa($name) };
+    };
 
-    unless (Class::MOP::IS_RUNNING_ON_5_10()) { 
-        # NOTE:
-        # We need to check for circular inheritance here
-        # if we are are not on 5.10, cause 5.8 detects it 
-        # late. This will do nothing if all is well, and 
-        # blow up otherwise. Yes, it's an ugly hack, better
-        # suggestions are welcome.        
-        # - SL
-        ($name || return)->isa('This is a test for circular inheritance') 
-    }
+    # Each class's list is only built once per call (in %$lists), however
+    # many times it shows up in a diamond.
+    my $dfs_precedence_list;
+    $dfs_precedence_list = sub {
+        my ( $name, $lists ) = @_;
+
+        return @{ $lists->{$name} ||= do {
+            # if our mro is c3, we can
+            # just grab the linear_isa
+            if ( mro::get_mro($name) eq 'c3' ) {
+                [ @{ mro::get_linear_isa($name) } ];
+            }
+            else {
+                # NOTE:
+                # we can't grab the linear_isa for dfs
+                # since it has all the duplicates
+                # already removed.
+                my @supers = do { no strict 'refs'; @{ $name . '::ISA' } };
+                [ $name, map { $dfs_precedence_list->( $_, $lists ) } @supers ];
+            }
+        } };
+    };
 
-    # if our mro is c3, we can 
-    # just grab the linear_isa
-    if (mro::get_mro($name) eq 'c3') {
-        return @{ mro::get_linear_isa($name) }
-    }
-    else {
-        # NOTE:
-        # we can't grab the linear_isa for dfs
-        # since it has all the duplicates 
-        # already removed.
-        return (
-            $name,
-            map {
-                Class::MOP::Class->initialize($_)->class_precedence_list()
-            } $self->superclasses()
-        );
+    $forget_precedence_list = sub { delete $precedence_lists{ $_[0] } };
+
+    sub class_precedence_list {
+        my $self = shift;
+        my $name = $self->name;
+
+        unless (Class::MOP::IS_RUNNING_ON_5_10()) { 
+            # NOTE:
+            # We need to check for circular inheritance here
+            # if we are are not on 5.10, cause 5.8 detects it 
+            # late. This will do nothing if all is well, and 
+            # blow up otherwise. Yes, it's an ugly hack, better
+            # suggestions are welcome.        
+            # - SL
+            ($name || return)->isa('This is a test for circular inheritance') 
+        }
+
+        my $stamp  = $hierarchy_stamp->($name);
+        my $cached = $precedence_lists{$name};
+
+        unless ( $cached && $cached->{stamp} eq $stamp ) {
+            $cached = $precedence_lists{$name} = {
+                stamp => $stamp,
+                list  => [ $dfs_precedence_list->( $name, {} ) ],
+            };
+        }
+
+        return @{ $cached->{list} };
     }
 }
 
@@ -928,6 +1288,14 @@ sub find_method_by_name {
     my ($self, $method_name) = @_;
     (defined $method_name && length $method_name)
         || confess "You must define a method name to find";
+
+    # perl's method cache usually knows which class the method comes from
+    my $owner = $self->_find_method_owner($method_name);
+    if ( defined $owner ) {
+        return unless length $owner;
+        return Class::MOP::Class->initialize($owner)->get_method($method_name);
+    }
+
     foreach my $class ($self->linearized_isa) {
         my $method = Class::MOP::Class->initialize($class)->get_method($method_name);
         return $method if defined $method;
@@ -949,6 +1317,29 @@ sub get_all_methods {
     return values %methods;
 }
 
+sub find_method_body_by_name {
+    my ($self, $method_name) = @_;
+    (defined $method_name && length $method_name)
+        || confess "You must define a method name to find";
+    foreach my $class ($self->linearized_isa) {
+        my $body = Class::MOP::Class->initialize($class)->_method_body($method_name);
+        return $body if defined $body;
+    }
+    return;
+}
+
+sub get_all_method_bodies {
+    my $self = shift;
+
+    my %bodies;
+    for my $class ( reverse $self->linearized_isa ) {
+        my $bodies = Class::MOP::Class->initialize($class)->_method_bodies;
+        @bodies{ keys %{$bodies} } = values %{$bodies};
+    }
+
+    return \%bodies;
+}
+
 sub get_all_method_names {
     my $self = shift;
     my %uniq;
@@ -1026,29 +1417,137 @@ sub remove_meta_instance_dependencies {
 
 }
 
-sub add_dependent_meta_instance {
-    my ( $self, $metaclass ) = @_;
-    push @{ $self->{dependent_meta_instances} }, $metaclass;
-}
+{
+    # The dependent metaclasses are still kept in a list, but each one is
+    # only in it once, and its place in the list is indexed by class name,
+    # so adding and removing one doesn't scan the list. They are weakened
+    # so that the dependency doesn't keep an anon class alive.
+    my $forget_dependent = sub {
+        my ( $self, $name ) = @_;
+
+        my $i = delete $self->{_dependent_meta_instance_index}{$name};
+        return unless defined $i;
+
+        my $list  = $self->{dependent_meta_instances};
+        my $names = $self->{_dependent_meta_instance_names};
+
+        # the last one takes the place of the removed one
+        my $last      = pop @$list;
+        my $last_name = pop @$names;
+        return if $i == @$list;
+
+        $list->[$i] = $last;
+        weaken $list->[$i] if $last;
+        $names->[$i] = $last_name;
+        $self->{_dependent_meta_instance_index}{$last_name} = $i;
+    };
 
-sub remove_dependent_meta_instance {
-    my ( $self, $metaclass ) = @_;
-    my $name = $metaclass->name;
-    @$_ = grep { $_->name ne $name } @$_
-        for $self->{dependent_meta_instances};
-}
+    sub add_dependent_meta_instance {
+        my ( $self, $metaclass ) = @_;
+        my $name  = $metaclass->name;
+        my $index = $self->{_dependent_meta_instance_index} ||= {};
+        my $list  = $self->{dependent_meta_instances}       ||= [];
 
-sub invalidate_meta_instances {
-    my $self = shift;
-    $_->invalidate_meta_instance()
-        for $self, @{ $self->{dependent_meta_instances} };
+        my $i = $index->{$name};
+        unless ( defined $i ) {
+            $i = $index->{$name} = @$list;
+            $self->{_dependent_meta_instance_names}[$i] = $name;
+        }
+
+        weaken( $list->[$i] = $metaclass );
+    }
+
+    sub remove_dependent_meta_instance {
+        my ( $self, $metaclass ) = @_;
+        $forget_dependent->( $self, $metaclass->name );
+    }
+
+    sub invalidate_meta_instances {
+        my $self = shift;
+        $self->_increment_generation;
+
+        # inside Class::MOP::batch_define, this waits until a meta instance
+        # is needed, or the batch ends
+        return if Class::MOP::_defer_check( $self, 'invalidate_meta_instances' );
+
+        $self->invalidate_meta_instance();
+
+        my $names = $self->{_dependent_meta_instance_names}
+            or return;
+
+        # copied, since dropping a dependent reorders the list
+        for my $name ( @{ [@$names] } ) {
+            my $i = $self->{_dependent_meta_instance_index}{$name};
+            if ( my $dependent = $self->{dependent_meta_instances}[$i] ) {
+                $dependent->invalidate_meta_instance();
+            }
+            else {
+                # the dependent class has gone away
+                $forget_dependent->( $self, $name );
+            }
+        }
+    }
 }
 
 sub invalidate_meta_instance {
     my $self = shift;
+    $self->_increment_generation;
     undef $self->{_meta_instance};
 }
 
+# Every change takes the next number from Class::MOP, so a class's
+# generation only ever goes up. generation() reads it in XS.
+sub _increment_generation {
+    $_[0]->{_generation} = Class::MOP::_next_generation();
+}
+
+# Class::MOP::Mixin::HasMethods doesn't know about generations, so adding
+# and removing methods is counted here.
+sub add_method {
+    my $self  = shift;
+    my $added = $self->SUPER::add_method(@_);
+    $self->_increment_generation;
+    return $added;
+}
+
+sub remove_method {
+    my $self    = shift;
+    my $removed = $self->SUPER::remove_method(@_);
+    $self->_increment_generation;
+    return $removed;
+}
+
+# The hierarchy generation is kept along with the generations it was
+# worked out from. Those are only looked at again once something has
+# changed since (through the MOP, or in the class's own package, such as
+# its @ISA), and it only goes up if one of them did.
+sub hierarchy_generation {
+    my $self = shift;
+
+    my $checked = Class::MOP::_last_generation() . ','
+        . mro::get_pkg_gen( $self->name );
+    return $self->{_hierarchy_generation}
+        if defined $self->{_hierarchy_checked}
+            && $self->{_hierarchy_checked} eq $checked;
+
+    no warnings 'uninitialized';
+    my $stamp = join ',', map {
+        my $meta = Class::MOP::get_metaclass_by_name($_);
+        $meta ? $_ . '=' . refaddr($meta) . '@' . $meta->{_generation} : $_;
+    } $self->linearized_isa;
+
+    unless ( defined $self->{_hierarchy_stamp}
+        && $self->{_hierarchy_stamp} eq $stamp ) {
+        $self->{_hierarchy_stamp}      = $stamp;
+        $self->{_hierarchy_generation} = Class::MOP::_next_generation();
+    }
+
+    $self->{_hierarchy_checked} = Class::MOP::_last_generation() . ','
+        . mro::get_pkg_gen( $self->name );
+
+    return $self->{_hierarchy_generation};
+}
+
 # check if we can reinitialize
 sub is_pristine {
     my $self = shift;
@@ -1094,6 +1593,11 @@ sub make_immutable {
     if ( $self->is_mutable ) {
         $self->_initialize_immutable( $self->_immutable_options(@args) );
         $self->_rebless_as_immutable(@args);
+        $self->_increment_generation;
+
+        Class::MOP::_notify_listeners( made_immutable => $self )
+            if $Class::MOP::LISTENERS{made_immutable};
+
         return $self;
     }
     else {
@@ -1109,6 +1613,11 @@ sub make_mutable {
         $self->_rebless_as_mutable();
         $self->_remove_inlined_code(@args);
         delete $self->{__immutable};
+        $self->_increment_generation;
+
+        Class::MOP::_notify_listeners( made_mutable => $self )
+            if $Class::MOP::LISTENERS{made_mutable};
+
         return $self;
     }
     else {
@@ -1418,6 +1927,15 @@ while any instances exist.
 
 This only works if the instance is based on a hash reference, however.
 
+If the C<cache> option is true, the class is cached, and a later call
+with the same options and C<cache> returns the same metaclass instead of
+creating a new class. Options are the same if their strings are equal
+and their references (code references, attribute defaults, and so on)
+are the same references. Attributes are compared by their class and
+their options, so they may be different objects. The cache does not keep
+the class alive, and the class should not be changed once it has been
+cached.
+
 =item B<< Class::MOP::Class->initialize($package_name, %options) >>
 
 This method will initialize a C<Class::MOP::Class> object for the
@@ -1535,6 +2053,29 @@ This returns true if the class has been made immutable.
 A class is I<not> pristine if it has non-inherited attributes or if it
 has any generated methods.
 
+=item B<< $metaclass->generation >>
+
+This returns a number which goes up whenever the class changes through
+the MOP: when a method or an attribute is added or removed, when its
+superclasses are set, when it is made immutable or mutable, and when its
+meta instance is thrown away. Changes which bypass the MOP, such as
+defining a sub directly, are not counted.
+
+The numbers come from one counter shared by all classes, so a
+replacement metaclass for the same class never reuses a number. Code
+which caches something computed from a class can store the generation
+and compare it later.
+
+=item B<< $metaclass->hierarchy_generation >>
+
+This is like C<generation>, but it also goes up when any superclass
+changes, when the metaclass of a superclass is replaced or removed, and
+when the class's own C<@ISA> is changed, even outside of the MOP.
+
+It is kept in the metaclass along with the generations of the class and
+its superclasses, which are only compared again when some class has
+changed since the last call, so reading it is cheap.
+
 =back
 
 =head2 Inheritance Relationships
@@ -1654,6 +2195,19 @@ returns C<undef>
 Unlike C<get_method>, this method I<will> look for the named method in
 superclasses.
 
+=item B<< $metaclass->find_method_body_by_name($method_name) >>
+
+This is like C<find_method_by_name>, but it returns the method's code
+reference instead of a L<Class::MOP::Method> object, and it does not
+create any method objects.
+
+=item B<< $metaclass->get_all_method_bodies >>
+
+This returns a hash reference of all the methods for this class and
+its parents, mapping each method's name to its code reference. It
+finds the same methods as C<get_all_methods>, but does not create any
+method objects.
+
 =item B<< $metaclass->get_all_method_names >>
 
 This will return a list of method I<names> for all of this class's
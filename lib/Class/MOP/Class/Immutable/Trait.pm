@@ -56,6 +56,12 @@ sub get_all_methods {
     @{ $self->{__immutable}{get_all_methods} ||= [ $self->$orig ] };
 }
 
+sub get_all_method_bodies {
+    my $orig = shift;
+    my $self = shift;
+    return { %{ $self->{__immutable}{get_all_method_bodies} ||= $self->$orig } };
+}
+
 sub get_all_method_names {
     my $orig = shift;
     my $self = shift;
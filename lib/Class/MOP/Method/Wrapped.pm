@@ -14,59 +14,81 @@ our $AUTHORITY = 'cpan:STEVAN';
 use base 'Class::MOP::Method';
 
 # NOTE:
-# this ugly beast is the result of trying
-# to micro optimize this as much as possible
-# while not completely loosing maintainability.
-# At this point it's "fast enough", after all
-# you can't get something for nothing :)
-my $_build_wrapped_method = sub {
-    my $modifier_table = shift;
-    my ($before, $after, $around) = (
-        $modifier_table->{before},
-        $modifier_table->{after},
-        $modifier_table->{around},
-    );
-    if (@$before && @$after) {
-        $modifier_table->{cache} = sub {
-            for my $c (@$before) { $c->(@_) };
-            my @rval;
-            ((defined wantarray) ?
-                ((wantarray) ?
-                    (@rval = $around->{cache}->(@_))
-                    :
-                    ($rval[0] = $around->{cache}->(@_)))
-                :
-                $around->{cache}->(@_));
-            for my $c (@$after) { $c->(@_) };
-            return unless defined wantarray;
-            return wantarray ? @rval : $rval[0];
-        }
-    }
-    elsif (@$before && !@$after) {
-        $modifier_table->{cache} = sub {
-            for my $c (@$before) { $c->(@_) };
-            return $around->{cache}->(@_);
-        }
-    }
-    elsif (@$after && !@$before) {
-        $modifier_table->{cache} = sub {
-            my @rval;
-            ((defined wantarray) ?
-                ((wantarray) ?
-                    (@rval = $around->{cache}->(@_))
-                    :
-                    ($rval[0] = $around->{cache}->(@_)))
-                :
-                $around->{cache}->(@_));
-            for my $c (@$after) { $c->(@_) };
-            return unless defined wantarray;
-            return wantarray ? @rval : $rval[0];
-        }
-    }
-    else {
-        $modifier_table->{cache} = $around->{cache};
-    }
-};
+# the dispatcher for a wrapped method is an
+# eval'd sub with the before and after modifier
+# calls unrolled. The around modifiers are not
+# part of it: they are still chained together
+# in add_around_modifier, and the dispatcher
+# only calls the outermost one directly. The
+# source only depends on how many before and
+# after modifiers there are, so it is compiled
+# once per shape into a generator, which closes
+# over the current modifiers. It is rebuilt
+# whenever a modifier is added.
+my $_build_wrapped_method;
+{
+    my %generators;
+
+    my $generator_for = sub {
+        my ($before_count, $after_count, $has_around) = @_;
+
+        return $generators{"$before_count,$after_count,$has_around"} ||= do {
+            my $call = $has_around
+                ? '$around->($around_next, @_)'
+                : '$orig->(@_)';
+
+            my $source = join "\n",
+                'sub {',
+                'my ($before, $after, $around, $around_next, $orig) = @_;',
+                ( map { "my \$before_$_ = \$before->[$_];" } 0 .. $before_count - 1 ),
+                ( map { "my \$after_$_ = \$after->[$_];" } 0 .. $after_count - 1 ),
+                'sub {',
+                ( map { "\$before_$_->(\@_);" } 0 .. $before_count - 1 ),
+                ( $after_count
+                    ? (
+                        'my @rval;',
+                        '((defined wantarray) ?',
+                        "    ((wantarray) ? (\@rval = $call) : (\$rval[0] = $call))",
+                        "    : $call);",
+                        ( map { "\$after_$_->(\@_);" } 0 .. $after_count - 1 ),
+                        'return unless defined wantarray;',
+                        'return wantarray ? @rval : $rval[0];',
+                    )
+                    : "return $call;"
+                ),
+                '}',
+                '}';
+
+            local $@;
+            local $SIG{__DIE__};
+            eval $source or confess "Could not compile the wrapped method: $@";
+        };
+    };
+
+    $_build_wrapped_method = sub {
+        my $modifier_table = shift;
+        my ($before, $after, $around) = (
+            $modifier_table->{before},
+            $modifier_table->{after},
+            $modifier_table->{around},
+        );
+
+        return $modifier_table->{cache} = $around->{cache}
+            unless @$before || @$after;
+
+        my $has_around = @{ $around->{methods} } ? 1 : 0;
+
+        $modifier_table->{cache}
+            = $generator_for->( scalar @$before, scalar @$after, $has_around )->(
+                [@$before],
+                [@$after],
+                ( $has_around
+                    ? ( $around->{methods}[0], $around->{next} )
+                    : ( undef, undef ) ),
+                $around->{cache},
+            );
+    };
+}
 
 sub wrap {
     my ( $class, $code, %params ) = @_;
@@ -85,6 +107,12 @@ sub wrap {
         },
     };
     $_build_wrapped_method->($modifier_table);
+    # NOTE:
+    # the installed sub stays the same when
+    # modifiers are added later, so anything
+    # which already refers to it (the symbol
+    # table included) sees them. That costs
+    # one extra call on top of the dispatcher.
     return $class->SUPER::wrap(
         sub { $modifier_table->{cache}->(@_) },
         # get these from the original
@@ -168,6 +196,14 @@ sub after_modifiers {
             @{$code->{'modifier_table'}->{around}->{methods}},
             $code->{'modifier_table'}->{orig}->body
         );
+        # what the outermost around modifier gets as
+        # its $orig, so the dispatcher can call it
+        # directly
+        my (undef, @inner) = @{$code->{'modifier_table'}->{around}->{methods}};
+        $code->{'modifier_table'}->{around}->{next} = $compile_around_method->(
+            @inner,
+            $code->{'modifier_table'}->{orig}->body
+        );
         $_build_wrapped_method->($code->{'modifier_table'});
     }
 }
@@ -37,6 +37,9 @@ sub add_attribute {
 
     $self->_attribute_map->{$attr_name} = $attribute;
 
+    Class::MOP::_index_attribute( $self->name, $attribute )
+        if $Class::MOP::ATTRIBUTE_INDEX;
+
     # This method is called to allow for installing accessors. Ideally, we'd
     # use method overriding, but then the subclass would be responsible for
     # making the attribute, which would end up with lots of code
@@ -45,6 +48,9 @@ sub add_attribute {
     $self->_post_add_attribute($attribute)
         if $self->can('_post_add_attribute');
 
+    Class::MOP::_notify_listeners( attribute_added => $self, $attribute )
+        if $Class::MOP::LISTENERS{attribute_added};
+
     return $attribute;
 }
 
@@ -77,6 +83,13 @@ sub remove_attribute {
 
     delete $self->_attribute_map->{$attribute_name};
 
+    Class::MOP::_unindex_attribute( $self->name, $attribute_name )
+        if $Class::MOP::ATTRIBUTE_INDEX;
+
+    Class::MOP::_notify_listeners(
+        attribute_removed => $self, $removed_attribute )
+        if $Class::MOP::LISTENERS{attribute_removed};
+
     return $removed_attribute;
 }
 
@@ -66,12 +66,22 @@ sub add_method {
         subname( $full_method_name => $body );
     }
 
-    $self->add_package_symbol(
+    my $added = $self->add_package_symbol(
         { sigil => '&', type => 'CODE', name => $method_name },
         $body,
     );
+
+    Class::MOP::_index_method( $self->name, $method_name )
+        if $Class::MOP::METHOD_INDEX;
+
+    Class::MOP::_notify_listeners( method_added => $self, $method_name )
+        if $Class::MOP::LISTENERS{method_added};
+
+    return $added;
 }
 
+# The XS lookups do the same check in C, and only call this when a subclass
+# has overridden it.
 sub _code_is_mine {
     my ( $self, $code ) = @_;
 
@@ -81,58 +91,19 @@ sub _code_is_mine {
         || ( $code_package eq 'constant' && $code_name eq '__ANON__' );
 }
 
-sub has_method {
-    my ( $self, $method_name ) = @_;
-
-    ( defined $method_name && length $method_name )
-        || confess "You must define a method name";
-
-    return defined( $self->get_method($method_name) );
-}
-
-sub get_method {
-    my ( $self, $method_name ) = @_;
-
-    ( defined $method_name && length $method_name )
-        || confess "You must define a method name";
-
-    my $method_map = $self->_method_map;
-    my $map_entry  = $method_map->{$method_name};
-    my $code       = $self->get_package_symbol(
-        {
-            name  => $method_name,
-            sigil => '&',
-            type  => 'CODE',
-        }
-    );
-
-    # This seems to happen in some weird cases where methods modifiers are
-    # added via roles or some other such bizareness. Honestly, I don't totally
-    # understand this, but returning the entry works, and keeps various MX
-    # modules from blowing up. - DR
-    return $map_entry if blessed $map_entry && !$code;
-
-    return $map_entry if blessed $map_entry && $map_entry->body == $code;
-
-    unless ($map_entry) {
-        return unless $code && $self->_code_is_mine($code);
-    }
-
-    $code ||= $map_entry;
-
-    return $method_map->{$method_name} = $self->wrap_method_body(
-        body                 => $code,
-        name                 => $method_name,
-        associated_metaclass => $self,
-    );
-}
+# get_method, has_method and get_method_list are implemented in
+# xs/HasMethods.xs
 
 sub remove_method {
     my ( $self, $method_name ) = @_;
     ( defined $method_name && length $method_name )
         || confess "You must define a method name";
 
-    my $removed_method = delete $self->_full_method_map->{$method_name};
+    # the map may only have the method's body, so let get_method wrap it
+    my $map = $self->_full_method_map;
+    my $removed_method
+        = exists $map->{$method_name} ? $self->get_method($method_name) : undef;
+    delete $map->{$method_name};
 
     $self->remove_package_symbol(
         { sigil => '&', type => 'CODE', name => $method_name } );
@@ -143,12 +114,13 @@ sub remove_method {
     # still valid, since we just removed the method from the map
     $self->update_package_cache_flag;
 
-    return $removed_method;
-}
+    Class::MOP::_unindex_method( $self->name, $method_name )
+        if $Class::MOP::METHOD_INDEX;
+
+    Class::MOP::_notify_listeners( method_removed => $self, $method_name )
+        if $Class::MOP::LISTENERS{method_removed};
 
-sub get_method_list {
-    my $self = shift;
-    return grep { $self->has_method($_) } keys %{ $self->namespace };
+    return $removed_method;
 }
 
 1;
@@ -55,9 +55,16 @@ sub reinitialize {
     $package_name = $package_name->name
         if blessed $package_name;
 
+    # the new metaclass keeps the old one's keys
+    my @keys = Class::MOP::get_metaclass_keys($package_name);
+
     Class::MOP::remove_metaclass_by_name($package_name);
 
-    $class->initialize($package_name, %options); # call with first arg form for compat
+    my $meta = $class->initialize($package_name, %options); # call with first arg form for compat
+
+    Class::MOP::store_metaclass_key( $_, $package_name ) for @keys;
+
+    return $meta;
 }
 
 sub _new {
@@ -133,6 +140,23 @@ sub list_all_package_symbols {
     $self->_package_stash->list_all_package_symbols(@_);
 }
 
+# ... and this one deals with whole trees of namespaces
+
+sub walk_packages {
+    my ( $self, $callback, %options ) = @_;
+
+    ( ref $callback && reftype($callback) eq 'CODE' )
+        || confess "You must pass a CODE reference to walk_packages";
+
+    my $root = $options{root};
+    $root = blessed $self ? $self->name : 'main'
+        unless defined $root;
+
+    _walk_packages( $root, $options{prefix}, $options{summary} ? 1 : 0, $callback );
+
+    return;
+}
+
 1;
 
 __END__
@@ -222,6 +246,90 @@ This works much like C<list_all_package_symbols>, but it returns a
 hash reference. The keys are glob names and the values are references
 to the value for that name.
 
+=item B<< $metapackage->get_all_package_symbols_by_type(@types) >>
+
+This fetches the symbols for several types at once, with a single pass
+over the package's symbol table. It takes one or more of 'SCALAR',
+'ARRAY', 'HASH', 'CODE' or 'IO' and returns a hash reference keyed by
+type, where each value is a hash reference like the one returned by
+C<get_all_package_symbols> for that type:
+
+  my $symbols = $metapackage->get_all_package_symbols_by_type(qw(CODE ARRAY));
+  my @subs    = keys %{ $symbols->{CODE} };
+
+=item B<< $metapackage->each_package_symbol($callback, $type_filter) >>
+
+This calls C<$callback> once for every symbol in the package, passing
+it the glob name and a reference to the value for that name, as
+C<get_all_package_symbols> would. Iteration stops as soon as the
+callback returns a false value, so packages with many symbols can be
+scanned without building a hash of all of them first.
+
+The type filter is optional and works like the one for
+C<list_all_package_symbols>.
+
+=item B<< $metapackage->package_symbol_iterator($type_filter) >>
+
+This returns a C<Class::MOP::Package::SymbolIterator> object for the
+package's symbols, or C<undef> if the package does not exist. Each call
+to the iterator's C<next> method returns the next glob name and value
+reference, and an empty list once all symbols have been seen:
+
+  my $iter = $metapackage->package_symbol_iterator('CODE');
+  while ( my ( $name, $code ) = $iter->next ) {
+      ...
+  }
+
+The iterator does not use the symbol table's own iteration state, so
+it is safe to look at the package while iterating. Adding or removing
+symbols during iteration may cause symbols to be skipped or seen
+twice.
+
+=item B<< Class::MOP::Package->walk_packages($callback, %options) >>
+
+=item B<< $metapackage->walk_packages($callback, %options) >>
+
+This walks a tree of nested packages, calling C<$callback> with the
+name of each package it finds. The walk stops as soon as the callback
+returns a false value. This is much faster than recursing through the
+symbol tables in Perl, and is a convenient way to find every package
+loaded in an application.
+
+When called on a metapackage object, the walk starts at that package,
+otherwise it starts at C<main>. It accepts the following options:
+
+=over 8
+
+=item * root
+
+The name of the package to start from, overriding the default.
+
+=item * prefix
+
+Only the package with this name and the packages nested in it are
+passed to the callback, so C<Foo> matches C<Foo::Bar> but not
+C<FooBar>. A prefix ending in C<::>, such as C<MyApp::>, only matches
+the packages nested in it. Only the parts of the tree which could
+contain such packages are visited.
+
+=item * summary
+
+If this is true, the callback also receives a hash reference with the
+number of symbols of each type ('SCALAR', 'ARRAY', 'HASH', 'CODE' and
+'IO') in the package. Nested packages are not counted.
+
+=back
+
+  Class::MOP::Package->walk_packages(
+      sub {
+          my ( $name, $summary ) = @_;
+          push @classes, $name if $summary->{CODE};
+          return 1;
+      },
+      prefix  => 'MyApp::',
+      summary => 1,
+  );
+
 =item B<< Class::MOP::Package->meta >>
 
 This will return a L<Class::MOP::Class> instance for this class.
@@ -82,10 +82,16 @@ mop_get_code_info (SV *coderef, char **pkg, char **name)
         return 0;
     }
 
-    coderef = SvRV(coderef);
+    return mop_get_cv_info((CV *)SvRV(coderef), pkg, name);
+}
 
+/* finds the glob and stash a sub was defined in. *gv is left NULL for a
+ * sub without a proper glob. Returns 0 if the sub is still being compiled. */
+int
+mop_cv_origin (CV *cv, GV **gv, HV **stash)
+{
     /* sub is still being compiled */
-    if (!CvGV(coderef)) {
+    if (!CvGV(cv)) {
         return 0;
     }
 
@@ -94,10 +100,30 @@ mop_get_code_info (SV *coderef, char **pkg, char **name)
        value strikes me as an improvement (mst)
     */
 
-    if ( isGV_with_GP(CvGV(coderef)) ) {
-        GV *gv   = CvGV(coderef);
-        *pkg     = HvNAME( GvSTASH(gv) ? GvSTASH(gv) : CvSTASH(coderef) );
-        *name    = GvNAME( CvGV(coderef) );
+    if ( isGV_with_GP(CvGV(cv)) ) {
+        *gv    = CvGV(cv);
+        *stash = GvSTASH(*gv) ? GvSTASH(*gv) : CvSTASH(cv);
+    } else {
+        *gv    = NULL;
+        *stash = NULL;
+    }
+
+    return 1;
+}
+
+int
+mop_get_cv_info (CV *cv, char **pkg, char **name)
+{
+    GV *gv;
+    HV *stash;
+
+    if (!mop_cv_origin(cv, &gv, &stash)) {
+        return 0;
+    }
+
+    if (gv) {
+        *pkg     = HvNAME(stash);
+        *name    = GvNAME(gv);
     } else {
         *pkg     = "__UNKNOWN__";
         *name    = "__ANON__";
@@ -106,6 +132,141 @@ mop_get_code_info (SV *coderef, char **pkg, char **name)
     return 1;
 }
 
+/* this checks to see that the subroutine is actually from the package, as
+ * opposed to being imported. The constant check is for subs which were
+ * created by constant.pm */
+bool
+mop_cv_is_from_package (CV *cv, const char *package)
+{
+    char *cvpkg_name;
+    char *cv_name;
+
+    if (!mop_get_cv_info(cv, &cvpkg_name, &cv_name)) {
+        return FALSE;
+    }
+
+    if (!cvpkg_name) {
+        return FALSE;
+    }
+
+    if ( strEQ(cvpkg_name, "constant") && strEQ(cv_name, "__ANON__") ) {
+        return TRUE;
+    }
+
+    return strEQ(cvpkg_name, package);
+}
+
+/* like mop_get_cv_info, but takes a coderef and returns new SVs instead of
+ * C strings. Where possible the SVs share the string buffers of the stash's
+ * and the glob's name HEKs instead of copying them. */
+int
+mop_get_code_info_sv (SV *coderef, SV **pkg, SV **name)
+{
+    GV *gv;
+    HV *stash;
+
+    if (!SvOK(coderef) || !SvROK(coderef) || SvTYPE(SvRV(coderef)) != SVt_PVCV) {
+        return 0;
+    }
+
+    if (!mop_cv_origin((CV *)SvRV(coderef), &gv, &stash)) {
+        return 0;
+    }
+
+    if (gv) {
+#ifdef HvNAME_HEK
+        *pkg      = HvNAME_HEK(stash) ? newSVhek(HvNAME_HEK(stash)) : newSVpvs("");
+        *name     = newSVhek(GvNAME_HEK(gv));
+#else
+        *pkg      = newSVpv(HvNAME(stash), 0);
+        *name     = newSVpv(GvNAME(gv), 0);
+#endif
+    } else {
+        *pkg      = newSVpvs("__UNKNOWN__");
+        *name     = newSVpvs("__ANON__");
+    }
+
+    return 1;
+}
+
+SV *
+mop_symbol_for_type (HV *stash, HE *he, type_filter_t filter)
+{
+    GV * const gv = (GV*)HeVAL(he);
+    SV *sv = NULL;
+
+    if (filter == TYPE_FILTER_NONE) {
+        return HeVAL(he);
+    }
+
+    if(isGV(gv)){
+        switch (filter) {
+            case TYPE_FILTER_CODE:   sv = (SV *)GvCVu(gv); break;
+            case TYPE_FILTER_ARRAY:  sv = (SV *)GvAV(gv);  break;
+            case TYPE_FILTER_IO:     sv = (SV *)GvIO(gv);  break;
+            case TYPE_FILTER_HASH:   sv = (SV *)GvHV(gv);  break;
+            case TYPE_FILTER_SCALAR: sv = (SV *)GvSV(gv);  break;
+            default:
+                croak("Unknown type");
+        }
+    }
+    /* expand the gv into a real typeglob if it
+     * contains stub functions or constants and we
+     * were asked to return CODE references */
+    else if (filter == TYPE_FILTER_CODE) {
+        STRLEN keylen;
+        const char * const key = HePV(he, keylen);
+        gv_init(gv, stash, key, keylen, GV_ADDMULTI);
+        sv = (SV *)GvCV(gv);
+    }
+
+    return sv;
+}
+
+/* the order in which the types of a single glob are reported */
+static const type_filter_t all_type_filters[TYPE_FILTER_COUNT] = {
+    TYPE_FILTER_CODE,
+    TYPE_FILTER_ARRAY,
+    TYPE_FILTER_IO,
+    TYPE_FILTER_HASH,
+    TYPE_FILTER_SCALAR,
+};
+
+type_filter_t
+mop_type_filter_for_name (const char *name)
+{
+    switch (*name) {
+        case 'C': return TYPE_FILTER_CODE;
+        case 'A': return TYPE_FILTER_ARRAY;
+        case 'I': return TYPE_FILTER_IO;
+        case 'H': return TYPE_FILTER_HASH;
+        case 'S': return TYPE_FILTER_SCALAR;
+        default:
+            croak("Unknown type %s\n", name);
+    }
+
+    return TYPE_FILTER_NONE; /* not reached */
+}
+
+const char *
+mop_type_filter_name (type_filter_t type)
+{
+    switch (type) {
+        case TYPE_FILTER_CODE:   return "CODE";
+        case TYPE_FILTER_ARRAY:  return "ARRAY";
+        case TYPE_FILTER_IO:     return "IO";
+        case TYPE_FILTER_HASH:   return "HASH";
+        case TYPE_FILTER_SCALAR: return "SCALAR";
+        default:
+            croak("Unknown type");
+    }
+
+    return NULL; /* not reached */
+}
+
+/* filter may have several TYPE_FILTER_* bits set, in which case the callback
+ * is called once for every requested type present in a glob, all in a single
+ * pass over the stash */
 void
 mop_get_package_symbols (HV *stash, type_filter_t filter, get_package_symbols_cb_t cb, void *ud)
 {
@@ -117,7 +278,7 @@ mop_get_package_symbols (HV *stash, type_filter_t filter, get_package_symbols_cb
         while ( (he = hv_iternext(stash)) ) {
             STRLEN keylen;
             const char *key = HePV(he, keylen);
-            if (!cb(key, keylen, HeVAL(he), ud)) {
+            if (!cb(key, keylen, TYPE_FILTER_NONE, HeVAL(he), ud)) {
                 return;
             }
         }
@@ -125,42 +286,109 @@ mop_get_package_symbols (HV *stash, type_filter_t filter, get_package_symbols_cb
     }
 
     while ( (he = hv_iternext(stash)) ) {
-        GV * const gv          = (GV*)HeVAL(he);
-        STRLEN keylen;
-        const char * const key = HePV(he, keylen);
-        SV *sv = NULL;
-
-        if(isGV(gv)){
-            switch (filter) {
-                case TYPE_FILTER_CODE:   sv = (SV *)GvCVu(gv); break;
-                case TYPE_FILTER_ARRAY:  sv = (SV *)GvAV(gv);  break;
-                case TYPE_FILTER_IO:     sv = (SV *)GvIO(gv);  break;
-                case TYPE_FILTER_HASH:   sv = (SV *)GvHV(gv);  break;
-                case TYPE_FILTER_SCALAR: sv = (SV *)GvSV(gv);  break;
-                default:
-                    croak("Unknown type");
+        int i;
+
+        for (i = 0; i < TYPE_FILTER_COUNT; i++) {
+            const type_filter_t type = all_type_filters[i];
+            SV *sv;
+
+            if (!(filter & type)) {
+                continue;
+            }
+
+            if ( (sv = mop_symbol_for_type(stash, he, type)) ) {
+                STRLEN keylen;
+                const char * const key = HePV(he, keylen);
+                if (!cb(key, keylen, type, sv, ud)) {
+                    return;
+                }
             }
         }
-        /* expand the gv into a real typeglob if it
-        * contains stub functions or constants and we
-        * were asked to return CODE references */
-        else if (filter == TYPE_FILTER_CODE) {
-            gv_init(gv, stash, key, keylen, GV_ADDMULTI);
-            sv = (SV *)GvCV(gv);
+    }
+}
+
+/* The symbol iterator walks the stash's buckets directly instead of using
+ * hv_iternext, so that it doesn't share (and trample) the iteration state of
+ * the stash itself. This lets an iteration be suspended between calls, and
+ * lets callbacks look at the same package while it is being iterated.
+ *
+ * It carries on from the entry it stopped at. If entries were added to or
+ * deleted from the stash in the meantime, that entry may be gone, so it finds
+ * its place again by counting along the current bucket instead. */
+
+void
+mop_symbol_iter_init (mop_symbol_iter_t *iter, HV *stash, type_filter_t filter)
+{
+    iter->stash    = (HV *)SvREFCNT_inc((SV *)stash);
+    iter->filter   = filter;
+    iter->bucket   = 0;
+    iter->position = 0;
+    iter->cursor   = NULL;
+    iter->array    = NULL;
+}
+
+void
+mop_symbol_iter_free (mop_symbol_iter_t *iter)
+{
+    SvREFCNT_dec((SV *)iter->stash);
+    iter->stash = NULL;
+}
+
+bool
+mop_symbol_iter_next (mop_symbol_iter_t *iter, get_package_symbols_cb_t cb, void *ud)
+{
+    HV *stash = iter->stash;
+
+    while (stash && HvARRAY(stash) && iter->bucket <= HvMAX(stash)) {
+        HE *he;
+        SV *sv;
+
+        if ( iter->array == HvARRAY(stash) && iter->keys == HvTOTALKEYS(stash)
+          && (!iter->cursor || HeKEY_hek(iter->cursor) == iter->cursor_hek) ) {
+            he = iter->cursor;
         }
+        else {
+            STRLEN i;
 
-        if (sv) {
-            if (!cb(key, keylen, sv, ud)) {
-                return;
+            he = HvARRAY(stash)[iter->bucket];
+            for (i = 0; he && i < iter->position; i++) {
+                he = HeNEXT(he);
             }
         }
+
+        if (!he) {
+            iter->bucket++;
+            iter->position = 0;
+            iter->cursor   = iter->bucket <= HvMAX(stash) ? HvARRAY(stash)[iter->bucket] : NULL;
+        }
+        else {
+            iter->position++;
+            iter->cursor = HeNEXT(he);
+        }
+
+        iter->cursor_hek = iter->cursor ? HeKEY_hek(iter->cursor) : NULL;
+        iter->array      = HvARRAY(stash);
+        iter->keys       = HvTOTALKEYS(stash);
+
+        if (!he || HeVAL(he) == &PL_sv_placeholder) {
+            continue;
+        }
+
+        if ( (sv = mop_symbol_for_type(stash, he, iter->filter)) ) {
+            STRLEN keylen;
+            const char * const key = HePV(he, keylen);
+            return cb(key, keylen, iter->filter, sv, ud);
+        }
     }
+
+    return FALSE;
 }
 
 static bool
-collect_all_symbols (const char *key, STRLEN keylen, SV *val, void *ud)
+collect_all_symbols (const char *key, STRLEN keylen, type_filter_t type, SV *val, void *ud)
 {
     HV *hash = (HV *)ud;
+    PERL_UNUSED_ARG(type);
 
     if (!hv_store (hash, key, keylen, newRV_inc(val), 0)) {
         croak("failed to store symbol ref");
@@ -177,6 +405,43 @@ mop_get_all_package_symbols (HV *stash, type_filter_t filter)
     return ret;
 }
 
+static bool
+collect_all_symbols_by_type (const char *key, STRLEN keylen, type_filter_t type, SV *val, void *ud)
+{
+    HV *by_type = (HV *)ud;
+    const char *type_name = mop_type_filter_name(type);
+    SV **hash = hv_fetch(by_type, type_name, strlen(type_name), 0);
+
+    if (!hash || !hv_store ((HV *)SvRV(*hash), key, keylen, newRV_inc(val), 0)) {
+        croak("failed to store symbol ref");
+    }
+
+    return TRUE;
+}
+
+/* returns { TYPE => { name => ref, ... }, ... } with an entry for every type
+ * in filter, even if the package has no symbols of that type */
+HV *
+mop_get_all_package_symbols_by_type (HV *stash, type_filter_t filter)
+{
+    HV *ret = newHV ();
+    int i;
+
+    for (i = 0; i < TYPE_FILTER_COUNT; i++) {
+        const char *type_name;
+
+        if (!(filter & all_type_filters[i])) {
+            continue;
+        }
+
+        type_name = mop_type_filter_name(all_type_filters[i]);
+        (void)hv_store(ret, type_name, strlen(type_name), newRV_noinc((SV *)newHV()), 0);
+    }
+
+    mop_get_package_symbols (stash, filter, collect_all_symbols_by_type, ret);
+    return ret;
+}
+
 #define DECLARE_KEY(name)                    { #name, #name, NULL, 0 }
 #define DECLARE_KEY_WITH_VALUE(name, value)  { #name, value, NULL, 0 }
 
@@ -191,11 +456,14 @@ static struct {
     DECLARE_KEY(package),
     DECLARE_KEY(package_name),
     DECLARE_KEY(body),
+    DECLARE_KEY(associated_metaclass),
+    DECLARE_KEY(original_method),
     DECLARE_KEY_WITH_VALUE(package_cache_flag, "_package_cache_flag"),
     DECLARE_KEY(methods),
     DECLARE_KEY(VERSION),
     DECLARE_KEY(ISA),
-    DECLARE_KEY_WITH_VALUE(_version, "-version")
+    DECLARE_KEY_WITH_VALUE(_version, "-version"),
+    DECLARE_KEY_WITH_VALUE(generation, "_generation")
 };
 
 SV *
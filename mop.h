@@ -23,11 +23,14 @@ typedef enum {
     KEY_package,
     KEY_package_name,
     KEY_body,
+    KEY_associated_metaclass,
+    KEY_original_method,
     KEY_package_cache_flag,
     KEY_methods,
     KEY_VERSION,
     KEY_ISA,
     KEY__version,
+    KEY_generation,
     key_last,
 } mop_prehashed_key_t;
 
@@ -49,24 +52,53 @@ XS(mop_xs_simple_reader);
 
 extern SV *mop_method_metaclass;
 extern SV *mop_associated_metaclass;
-extern SV *mop_wrap;
+extern SV *mop_wrap_method_body;
 
 UV mop_check_package_cache_flag(pTHX_ HV *stash);
 int mop_get_code_info (SV *coderef, char **pkg, char **name);
+int mop_get_code_info_sv (SV *coderef, SV **pkg, SV **name);
+int mop_get_cv_info (CV *cv, char **pkg, char **name);
+int mop_cv_origin (CV *cv, GV **gv, HV **stash);
+bool mop_cv_is_from_package (CV *cv, const char *package);
 SV *mop_call0(pTHX_ SV *const self, SV *const method);
 
+/* these are bit flags, so that several types can be requested at once */
 typedef enum {
-    TYPE_FILTER_NONE,
-    TYPE_FILTER_CODE,
-    TYPE_FILTER_ARRAY,
-    TYPE_FILTER_IO,
-    TYPE_FILTER_HASH,
-    TYPE_FILTER_SCALAR,
+    TYPE_FILTER_NONE   = 0,
+    TYPE_FILTER_CODE   = 1 << 0,
+    TYPE_FILTER_ARRAY  = 1 << 1,
+    TYPE_FILTER_IO     = 1 << 2,
+    TYPE_FILTER_HASH   = 1 << 3,
+    TYPE_FILTER_SCALAR = 1 << 4,
 } type_filter_t;
 
-typedef bool (*get_package_symbols_cb_t) (const char *, STRLEN, SV *, void *);
+#define TYPE_FILTER_COUNT 5
 
+type_filter_t mop_type_filter_for_name (const char *name);
+const char *mop_type_filter_name (type_filter_t type);
+
+typedef bool (*get_package_symbols_cb_t) (const char *, STRLEN, type_filter_t, SV *, void *);
+
+SV *mop_symbol_for_type (HV *stash, HE *he, type_filter_t type);
 void mop_get_package_symbols(HV *stash, type_filter_t filter, get_package_symbols_cb_t cb, void *ud);
 HV *mop_get_all_package_symbols (HV *stash, type_filter_t filter);
+HV *mop_get_all_package_symbols_by_type (HV *stash, type_filter_t filter);
+
+typedef struct {
+    HV *stash;
+    type_filter_t filter;
+    STRLEN bucket;
+    STRLEN position;
+    /* the entry after the last one returned, and what the stash looked
+     * like then; it is only used if the stash is unchanged since */
+    HE *cursor;
+    HEK *cursor_hek;
+    HE **array;
+    STRLEN keys;
+} mop_symbol_iter_t;
+
+void mop_symbol_iter_init (mop_symbol_iter_t *iter, HV *stash, type_filter_t filter);
+void mop_symbol_iter_free (mop_symbol_iter_t *iter);
+bool mop_symbol_iter_next (mop_symbol_iter_t *iter, get_package_symbols_cb_t cb, void *ud);
 
 #endif
@@ -157,4 +157,44 @@ is_deeply(
     [ @CLASS_PRECEDENCE_LIST ],
     '... Foo::Bar::Baz->meta->class_precedence_list == @CLASS_PRECEDENCE_LIST');
 
+# a stack of diamonds: each level's Left and Right both inherit from the
+# level below it
+
+sub naive_cpl {
+    my $name = shift;
+    no strict 'refs';
+    return ( $name, map { naive_cpl($_) } @{ $name . '::ISA' } );
+}
+
+{
+    no strict 'refs';
+    my $below = 'Diamond::Base';
+    for my $level ( 1 .. 8 ) {
+        @{"Diamond::Left$level\::ISA"}  = ($below);
+        @{"Diamond::Right$level\::ISA"} = ($below);
+        @{"Diamond::Top$level\::ISA"}   = ( "Diamond::Left$level", "Diamond::Right$level" );
+        $below = "Diamond::Top$level";
+    }
+}
+
+my $top = Class::MOP::Class->initialize('Diamond::Top8');
+my @cpl = $top->class_precedence_list;
+is( scalar @cpl, 3 * ( 2**8 - 1 ) + 2**8, '... stacked diamonds keep all the duplicates' );
+is_deeply( \@cpl, [ naive_cpl('Diamond::Top8') ], '... in depth first order' );
+is_deeply( [ $top->class_precedence_list ], \@cpl, '... and the same list the second time' );
+
+@Diamond::Left1::ISA = ();
+is_deeply(
+    [ $top->class_precedence_list ],
+    [ naive_cpl('Diamond::Top8') ],
+    '... an @ISA change far up the hierarchy is noticed'
+);
+
+Class::MOP::remove_metaclass_by_name('Diamond::Top8');
+is_deeply(
+    [ Class::MOP::Class->initialize('Diamond::Top8')->class_precedence_list ],
+    [ naive_cpl('Diamond::Top8') ],
+    '... and a class whose metaclass was removed gets its list rebuilt'
+);
+
 done_testing;
@@ -33,6 +33,8 @@ my @class_mop_package_methods = qw(
 
     add_package_symbol get_package_symbol has_package_symbol remove_package_symbol
     list_all_package_symbols get_all_package_symbols remove_package_glob
+    get_all_package_symbols_by_type each_package_symbol package_symbol_iterator
+    walk_packages _walk_packages
 
     _package_stash
 
@@ -57,7 +59,7 @@ my @class_mop_class_methods = qw(
     update_package_cache_flag
     reset_package_cache_flag
 
-    create_anon_class is_anon_class
+    create_anon_class _anon_class_cache_key is_anon_class
 
     instance_metaclass get_meta_instance
     create_meta_instance _create_meta_instance
@@ -65,8 +67,9 @@ my @class_mop_class_methods = qw(
     construct_instance _construct_instance
     construct_class_instance _construct_class_instance
     clone_instance _clone_instance
-    rebless_instance rebless_instance_back rebless_instance_away
+    rebless_instance rebless_instance_back rebless_instance_away _reblesser
     check_metaclass_compatibility _check_metaclass_compatibility
+    _check_metaclass_compatibility_uncached
     _check_class_metaclass_compatibility _check_single_metaclass_compatibility
     _class_metaclass_is_compatible _single_metaclass_is_compatible
     _fix_metaclass_incompatibility _fix_class_metaclass_incompatibility
@@ -78,13 +81,17 @@ my @class_mop_class_methods = qw(
 
     add_meta_instance_dependencies remove_meta_instance_dependencies update_meta_instance_dependencies
     add_dependent_meta_instance remove_dependent_meta_instance
-    invalidate_meta_instances invalidate_meta_instance
+    invalidate_meta_instances invalidate_meta_instance _increment_generation
+    add_method remove_method
+    generation hierarchy_generation
 
     superclasses subclasses direct_subclasses class_precedence_list
     linearized_isa _superclasses_updated
 
     alias_method get_all_method_names get_all_methods compute_all_applicable_methods
         find_method_by_name find_all_methods_by_name find_next_method_by_name
+        _find_method_owner
+        get_all_method_bodies find_method_body_by_name
 
         add_before_method_modifier add_after_method_modifier add_around_method_modifier
 
@@ -92,7 +99,7 @@ my @class_mop_class_methods = qw(
     _post_add_attribute
     remove_attribute
     find_attribute_by_name
-    get_all_attributes
+    get_all_attributes _construction_plan
 
     compute_all_applicable_attributes
     get_attribute_map
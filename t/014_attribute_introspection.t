@@ -22,6 +22,8 @@ use Class::MOP;
 
         initialize_instance_slot
         _set_initial_slot_value
+        _construction_step
+        _rebless_step
 
         name
         has_accessor      accessor
@@ -65,4 +65,39 @@ isa_ok($instance_2, ('Class::MOP::Class::__ANON__::SERIAL::' . $anon_class_id));
 ok(!$instance_2->isa('Foo'), '... but the new instance is not a Foo');
 ok(!$instance_2->can('foo'), '... and it can no longer call the foo method');
 
+{
+    my $anon = Class::MOP::Class->create_anon_class;
+    ok( $anon->is_anon_class, 'is_anon_class' );
+    ok( !Class::MOP::Class->initialize('Foo')->is_anon_class,
+        '... not for named classes' );
+    is( $anon->{_is_anon_class}, 1,
+        '... which is recorded when the metaclass is constructed' );
+    is( Class::MOP::Class->initialize('Foo')->{_is_anon_class}, 0,
+        '... for named classes too' );
+}
+
+{
+    my ( @names, $during );
+    Class::MOP::batch_define {
+        {
+            my $parent = Class::MOP::Class->create_anon_class(
+                superclasses => ['Foo'],
+            );
+            my $child = Class::MOP::Class->create_anon_class(
+                superclasses => [ $parent->name ],
+            );
+            @names = map { $_->name } $parent, $child;
+        }
+
+        $during = grep { !Class::MOP::does_metaclass_exist($_) } @names;
+        ok( $names[1]->isa('Foo'),
+            'inside batch_define, packages of dead anon classes are kept' );
+    };
+
+    is( $during, 2, '... but their metaclasses are gone' );
+    ok( !$names[1]->isa('Foo'), '... and the packages are removed at the end' );
+    ok( !exists $main::Class::MOP::Class::__ANON__::SERIAL::{ ( $_ =~ /(\d+)$/ )[0] . '::' },
+        "... $_ no longer exists" ) for @names;
+}
+
 done_testing;
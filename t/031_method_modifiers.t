@@ -206,4 +206,93 @@ use Class::MOP::Method;
                'check around_modifiers' );
 }
 
+{
+    my @trace;
+    my $method = Class::MOP::Method->wrap(
+        sub { push @trace, 'orig'; wantarray ? ( 1, 2 ) : defined wantarray ? 'scalar' : () },
+        package_name => 'main',
+        name         => 'contexts',
+    );
+    my $wrapped = Class::MOP::Method::Wrapped->wrap($method);
+
+    my $check = sub {
+        my ( $desc, $expected ) = @_;
+
+        @trace = ();
+        my @list = $wrapped->body->('arg');
+        is_deeply( \@list, [ 1, 2 ], "$desc: list context" );
+
+        my $scalar = $wrapped->body->('arg');
+        is( $scalar, 'scalar', "$desc: scalar context" );
+
+        $wrapped->body->('arg');
+        is_deeply( \@trace, [ (@$expected) x 3 ], "$desc: modifiers ran in order" );
+    };
+
+    $check->( 'no modifiers', ['orig'] );
+
+    for my $n ( 1 .. 2 ) {
+        $wrapped->add_before_modifier( sub { push @trace, "before$n:$_[0]" } );
+    }
+    $check->( 'before', [qw( before2:arg before1:arg orig )] );
+
+    for my $n ( 1 .. 2 ) {
+        $wrapped->add_after_modifier( sub { push @trace, "after$n:$_[0]" } );
+    }
+    $check->( 'before and after',
+        [qw( before2:arg before1:arg orig after1:arg after2:arg )] );
+
+    for my $n ( 1 .. 2 ) {
+        $wrapped->add_around_modifier(
+            sub {
+                my $orig = shift;
+                push @trace, "around$n";
+                $orig->(@_);
+            }
+        );
+    }
+    $check->(
+        'before, after and around',
+        [qw( before2:arg before1:arg around2 around1 orig after1:arg after2:arg )]
+    );
+
+    # the same shape as $wrapped, so both use the same generated dispatcher
+    my @other_trace;
+    my $other = Class::MOP::Method::Wrapped->wrap(
+        Class::MOP::Method->wrap(
+            sub { push @other_trace, 'orig'; 'other' },
+            package_name => 'main',
+            name         => 'other',
+        )
+    );
+    for my $n ( 1 .. 2 ) {
+        $other->add_before_modifier( sub { push @other_trace, "before$n" } );
+        $other->add_after_modifier( sub { push @other_trace, "after$n" } );
+        $other->add_around_modifier(
+            sub {
+                my $orig = shift;
+                push @other_trace, "around$n";
+                $orig->(@_);
+            }
+        );
+    }
+
+    @trace = ();
+    is( $other->body->('arg'), 'other',
+        'a wrapped method with the same modifier counts' );
+    is_deeply( \@other_trace,
+        [qw( before2 before1 around2 around1 orig after1 after2 )],
+        '... runs its own modifiers' );
+    is_deeply( \@trace, [], '... and not those of the other method' );
+
+    @other_trace = ();
+    $wrapped->body->('arg');
+    is_deeply(
+        \@trace,
+        [qw( before2:arg before1:arg around2 around1 orig after1:arg after2:arg )],
+        '... which still runs its own'
+    );
+    is_deeply( \@other_trace, [], '... only' );
+}
+
 done_testing;
@@ -0,0 +1,90 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+use Class::MOP;
+
+my $parent = Class::MOP::Class->create('Gen::Parent');
+my $child  = Class::MOP::Class->create(
+    'Gen::Child',
+    superclasses => ['Gen::Parent'],
+);
+my $other = Class::MOP::Class->create('Gen::Other');
+
+ok( $child->generation, 'a new class has a generation' );
+ok( $child->hierarchy_generation >= $parent->generation,
+    '... and its hierarchy generation is at least its parent\'s' );
+
+sub changes {
+    my ( $meta, $code ) = @_;
+    my ( $generation, $hierarchy )
+        = ( $meta->generation, $meta->hierarchy_generation );
+    $code->();
+    return [
+        $meta->generation > $generation           ? 1 : 0,
+        $meta->hierarchy_generation > $hierarchy  ? 1 : 0,
+    ];
+}
+
+is_deeply( changes( $child, sub { $child->add_method( foo => sub {1} ) } ),
+    [ 1, 1 ], 'add_method' );
+is_deeply( changes( $child, sub { $child->remove_method('foo') } ),
+    [ 1, 1 ], 'remove_method' );
+is_deeply( changes( $child, sub { $child->add_attribute('bar') } ),
+    [ 1, 1 ], 'add_attribute' );
+is_deeply( changes( $child, sub { $child->remove_attribute('bar') } ),
+    [ 1, 1 ], 'remove_attribute' );
+is_deeply( changes( $child, sub { $child->superclasses('Gen::Parent') } ),
+    [ 1, 1 ], 'superclasses' );
+is_deeply( changes( $child, sub { $child->get_all_attributes } ),
+    [ 0, 0 ], 'reading does not change anything' );
+
+is_deeply( changes( $child, sub { $parent->add_attribute('baz') } ),
+    [ 0, 1 ], 'changing the parent changes the hierarchy generation' );
+is_deeply( changes( $other, sub { $parent->add_method( quux => sub {1} ) } ),
+    [ 0, 0 ], '... of subclasses only' );
+
+{
+    my $grandchild = Class::MOP::Class->create(
+        'Gen::Grandchild',
+        superclasses => ['Gen::Child'],
+    );
+    is_deeply(
+        changes( $grandchild, sub { $parent->add_method( corge => sub {1} ) } ),
+        [ 0, 1 ], '... however far down they are'
+    );
+    ok( $grandchild->hierarchy_generation >= $parent->generation,
+        'the hierarchy generation is at least the newest generation in the hierarchy' );
+
+    my $hierarchy = $grandchild->hierarchy_generation;
+    $other->add_method( garply => sub {1} );
+    is( $grandchild->hierarchy_generation, $hierarchy,
+        '... and stays the same when other classes change' );
+
+    Class::MOP::Class->reinitialize('Gen::Parent');
+    ok( $grandchild->hierarchy_generation > $hierarchy,
+        'reinitializing a superclass changes the hierarchy generation' );
+
+    $hierarchy = $grandchild->hierarchy_generation;
+    Class::MOP::remove_metaclass_by_name('Gen::Parent');
+    ok( $grandchild->hierarchy_generation > $hierarchy,
+        '... and so does removing its metaclass' );
+    $parent = Class::MOP::Class->initialize('Gen::Parent');
+}
+
+is_deeply(
+    changes( $child, sub { $child->make_immutable( inline_constructor => 0 ) } ),
+    [ 1, 1 ], 'make_immutable'
+);
+is_deeply( changes( $child, sub { $child->make_mutable } ),
+    [ 1, 1 ], 'make_mutable' );
+
+{
+    my $generation = $other->generation;
+    my $new = Class::MOP::Class->reinitialize('Gen::Other');
+    ok( $new->generation > $generation,
+        'a reinitialized metaclass does not start over' );
+}
+
+done_testing;
@@ -0,0 +1,89 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+sub classes_with {
+    return [ sort map { $_->name } Class::MOP::get_metaclasses_by_method_name(shift) ];
+}
+
+{
+    package Index::Foo;
+    sub shared { }
+    sub foo_only { }
+
+    package Index::Bar;
+    our @ISA = ('Index::Foo');
+    sub shared { }
+}
+
+my $foo = Class::MOP::Class->initialize('Index::Foo');
+my $bar = Class::MOP::Class->initialize('Index::Bar');
+
+is_deeply( classes_with('shared'), [qw( Index::Bar Index::Foo )],
+    'classes defining a method' );
+is_deeply( classes_with('foo_only'), ['Index::Foo'],
+    '... inherited methods do not count' );
+is_deeply( classes_with('nonexistent'), [], 'no classes' );
+
+$bar->add_method( added => sub { } );
+is_deeply( classes_with('added'), ['Index::Bar'], 'add_method' );
+
+$bar->remove_method('shared');
+is_deeply( classes_with('shared'), ['Index::Foo'], 'remove_method' );
+
+my $baz = Class::MOP::Class->create(
+    'Index::Baz',
+    methods => { shared => sub { } },
+);
+is_deeply( classes_with('shared'), [qw( Index::Baz Index::Foo )],
+    'new classes are indexed' );
+
+eval 'package Index::Baz; sub direct { } 1' or die $@;
+$baz->_full_method_map;
+is_deeply( classes_with('direct'), ['Index::Baz'],
+    'subs added to the symbol table are indexed when the method map is rebuilt' );
+
+eval 'sub Index::Baz::late { 1 } 1' or die $@;
+is_deeply( classes_with('late'), [],
+    'a sub defined straight into the stash is not seen by the index' );
+$baz->_full_method_map;
+is_deeply( classes_with('late'), ['Index::Baz'],
+    '... until the method map is rebuilt' );
+
+delete $Index::Baz::{late};
+$baz->_full_method_map;
+is_deeply( classes_with('late'), [],
+    'deleting it from the stash is picked up the same way' );
+
+{
+    my $indexed = 0;
+    no warnings 'redefine';
+    local *Class::MOP::_index_methods = sub { $indexed++ };
+
+    eval 'sub Index::Foo::unseen { 1 } 1' or die $@;
+    classes_with('unseen');
+    is( $indexed, 0, 'lookups do not reindex any class' );
+}
+
+{
+    my $anon = Class::MOP::Class->create_anon_class(
+        methods => { anon_method => sub { } },
+    );
+    is_deeply( classes_with('anon_method'), [ $anon->name ], 'anon classes' );
+}
+is_deeply( classes_with('anon_method'), [],
+    '... which are removed from the index when they go away' );
+
+Class::MOP::remove_metaclass_by_name('Index::Baz');
+is_deeply( classes_with('shared'), ['Index::Foo'],
+    'removing a metaclass removes it from the index' );
+Class::MOP::store_metaclass_by_name( 'Index::Baz', $baz );
+
+throws_ok { Class::MOP::get_metaclasses_by_method_name('') }
+    qr/You must define a method name/, 'a method name is required';
+
+done_testing;
@@ -0,0 +1,84 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+sub names { [ sort map { $_->name } @_ ] }
+
+my $parent = Class::MOP::Class->create(
+    'AttrIndex::Parent',
+    attributes => [
+        Class::MOP::Attribute->new( 'customer_id', init_arg => 'customer' ),
+        Class::MOP::Attribute->new( 'internal', init_arg => undef ),
+    ],
+);
+my $child = Class::MOP::Class->create(
+    'AttrIndex::Child',
+    superclasses => ['AttrIndex::Parent'],
+);
+my $override = Class::MOP::Class->create(
+    'AttrIndex::Override',
+    superclasses => ['AttrIndex::Parent'],
+    attributes   => [
+        Class::MOP::Attribute->new( 'customer_id', init_arg => 'customer_ref' ),
+    ],
+);
+
+is_deeply( names( Class::MOP::get_metaclasses_by_attribute_name('customer_id') ),
+    [qw( AttrIndex::Override AttrIndex::Parent )],
+    'classes with an attribute' );
+is_deeply(
+    names( Class::MOP::get_metaclasses_by_attribute_name( 'customer_id', inherited => 1 ) ),
+    [qw( AttrIndex::Child AttrIndex::Override AttrIndex::Parent )],
+    '... including subclasses'
+);
+
+is_deeply( names( Class::MOP::get_metaclasses_by_init_arg('customer') ),
+    ['AttrIndex::Parent'], 'classes with an init_arg' );
+is_deeply(
+    names( Class::MOP::get_metaclasses_by_init_arg( 'customer', inherited => 1 ) ),
+    [qw( AttrIndex::Child AttrIndex::Parent )],
+    '... including subclasses which still accept it'
+);
+is_deeply( names( Class::MOP::get_metaclasses_by_init_arg('customer_ref') ),
+    ['AttrIndex::Override'], '... an overridden init_arg' );
+is_deeply( names( Class::MOP::get_metaclasses_by_init_arg('internal') ),
+    [], 'attributes without an init_arg' );
+
+$child->add_attribute( 'added', init_arg => 'added_arg' );
+is_deeply( names( Class::MOP::get_metaclasses_by_attribute_name('added') ),
+    ['AttrIndex::Child'], 'add_attribute' );
+is_deeply( names( Class::MOP::get_metaclasses_by_init_arg('added_arg') ),
+    ['AttrIndex::Child'], '... and its init_arg' );
+
+$child->add_attribute( 'added', init_arg => 'other_arg' );
+is_deeply( names( Class::MOP::get_metaclasses_by_init_arg('added_arg') ),
+    [], 'replacing an attribute forgets its old init_arg' );
+is_deeply( names( Class::MOP::get_metaclasses_by_init_arg('other_arg') ),
+    ['AttrIndex::Child'], '... and indexes the new one' );
+
+$child->remove_attribute('added');
+is_deeply( names( Class::MOP::get_metaclasses_by_attribute_name('added') ),
+    [], 'remove_attribute' );
+is_deeply( names( Class::MOP::get_metaclasses_by_init_arg('other_arg') ),
+    [], '... and its init_arg' );
+
+{
+    my $anon = Class::MOP::Class->create_anon_class(
+        attributes => [ Class::MOP::Attribute->new('anon_attr') ],
+    );
+    is_deeply( names( Class::MOP::get_metaclasses_by_attribute_name('anon_attr') ),
+        [ $anon->name ], 'anon classes' );
+}
+is_deeply( names( Class::MOP::get_metaclasses_by_attribute_name('anon_attr') ),
+    [], '... which are removed from the index when they go away' );
+
+throws_ok { Class::MOP::get_metaclasses_by_attribute_name(undef) }
+    qr/You must define an attribute name/, 'an attribute name is required';
+throws_ok { Class::MOP::get_metaclasses_by_init_arg(undef) }
+    qr/You must define an init_arg/, 'an init_arg is required';
+
+done_testing;
@@ -0,0 +1,64 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+my $person = Class::MOP::Class->create('My::App::Person');
+my $order  = Class::MOP::Class->create('My::App::Order');
+
+Class::MOP::store_metaclass_key( person => 'My::App::Person' );
+Class::MOP::store_metaclass_key( people => 'My::App::Person' );
+Class::MOP::store_metaclass_key( order  => 'My::App::Order' );
+
+is( Class::MOP::get_metaclass_by_key('person'), $person, 'get_metaclass_by_key' );
+is( Class::MOP::get_metaclass_by_key('people'), $person, '... a second key' );
+is( Class::MOP::get_metaclass_by_key('nobody'), undef, '... an unknown key' );
+
+is_deeply(
+    [ Class::MOP::get_metaclasses_by_keys(qw( order nobody person )) ],
+    [ $order, undef, $person ],
+    'get_metaclasses_by_keys'
+);
+
+is_deeply( [ sort( Class::MOP::get_metaclass_keys('My::App::Person') ) ],
+    [qw( people person )], 'get_metaclass_keys' );
+
+lives_ok { Class::MOP::store_metaclass_key( person => 'My::App::Person' ) }
+    'storing the same key again is fine';
+throws_ok { Class::MOP::store_metaclass_key( person => 'My::App::Order' ) }
+    qr/The key \(person\) is already used by \(My::App::Person\)/,
+    '... but not for another class';
+throws_ok { Class::MOP::store_metaclass_key( ghost => 'My::App::Ghost' ) }
+    qr/There is no metaclass for \(My::App::Ghost\)/,
+    'the class must have a metaclass';
+throws_ok { Class::MOP::store_metaclass_key( '' => 'My::App::Person' ) }
+    qr/You must define a key/, 'the key must be defined';
+
+Class::MOP::remove_metaclass_key('people');
+is( Class::MOP::get_metaclass_by_key('people'), undef, 'remove_metaclass_key' );
+is_deeply( [ Class::MOP::get_metaclass_keys('My::App::Person') ], ['person'],
+    '... which removes it from the class\'s keys' );
+
+my $new_person = Class::MOP::Class->reinitialize('My::App::Person');
+is( Class::MOP::get_metaclass_by_key('person'), $new_person,
+    'keys find a reinitialized metaclass' );
+
+Class::MOP::remove_metaclass_by_name('My::App::Order');
+is( Class::MOP::get_metaclass_by_key('order'), undef,
+    'removing a metaclass removes its keys' );
+Class::MOP::store_metaclass_by_name( 'My::App::Order', $order );
+is( Class::MOP::get_metaclass_by_key('order'), undef,
+    '... and storing it again does not bring them back' );
+
+{
+    my $anon = Class::MOP::Class->create_anon_class;
+    Class::MOP::store_metaclass_key( anon => $anon->name );
+    is( Class::MOP::get_metaclass_by_key('anon'), $anon, 'anon classes' );
+}
+is( Class::MOP::get_metaclass_by_key('anon'), undef,
+    '... lose their keys when they go away' );
+
+done_testing;
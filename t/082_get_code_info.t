@@ -49,4 +49,35 @@ code_name_is( \&Class::MOP::Method::name, "Class::MOP::Method", "name" );
     sub foo : Bar {}
 }
 
+{
+    my @code = (
+        sub {},
+        subname("Foo::bar", sub {}),
+        "not code",
+        \&Class::MOP::Method::name,
+        undef,
+    );
+
+    is_deeply(
+        [ Class::MOP::get_code_info_list(\@code) ],
+        [
+            main                 => "__ANON__",
+            Foo                  => "bar",
+            undef, undef,
+            "Class::MOP::Method" => "name",
+            undef, undef,
+        ],
+        "get_code_info_list returns a name pair for every element"
+    );
+
+    is_deeply(
+        [ Class::MOP::get_code_info_list([]) ],
+        [],
+        "get_code_info_list on an empty list"
+    );
+
+    eval { Class::MOP::get_code_info_list("foo") };
+    ok( $@, "get_code_info_list requires an array reference" );
+}
+
 done_testing;
@@ -0,0 +1,115 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Scalar::Util 'blessed';
+
+use Class::MOP;
+
+my @events;
+my %listeners = map {
+    my $event = $_;
+    $event => Class::MOP::add_metaclass_listener(
+        $event => sub {
+            my ( $meta, $event, @args ) = @_;
+            push @events, [
+                $meta->name, $event,
+                map { blessed($_) ? $_->name : $_ } @args
+            ];
+        }
+    );
+} qw(
+    method_added method_removed
+    attribute_added attribute_removed
+    superclasses_changed
+    made_immutable made_mutable
+);
+
+sub events_for (&) {
+    @events = ();
+    shift->();
+    return [@events];
+}
+
+Class::MOP::Class->create('Listen::Parent');
+my $meta = Class::MOP::Class->create('Listen::Child');
+
+is_deeply(
+    events_for { $meta->add_method( foo => sub {1} ) },
+    [ [ 'Listen::Child', 'method_added', 'foo' ] ],
+    'method_added'
+);
+
+is_deeply(
+    events_for { $meta->remove_method('foo') },
+    [ [ 'Listen::Child', 'method_removed', 'foo' ] ],
+    'method_removed'
+);
+
+is_deeply(
+    events_for { $meta->add_attribute('bar') },
+    [ [ 'Listen::Child', 'attribute_added', 'bar' ] ],
+    'attribute_added'
+);
+
+is_deeply(
+    events_for { $meta->add_attribute( 'bar', reader => 'bar' ) },
+    [
+        [ 'Listen::Child', 'attribute_removed', 'bar' ],
+        [ 'Listen::Child', 'method_added',      'bar' ],
+        [ 'Listen::Child', 'attribute_added',   'bar' ],
+    ],
+    'replacing an attribute removes the old one, and adds its accessors'
+);
+
+is_deeply(
+    events_for { $meta->remove_attribute('bar') },
+    [
+        [ 'Listen::Child', 'attribute_removed', 'bar' ],
+        [ 'Listen::Child', 'method_removed',    'bar' ],
+    ],
+    'attribute_removed, and the accessors are removed'
+);
+
+is_deeply(
+    events_for { $meta->superclasses('Listen::Parent') },
+    [ [ 'Listen::Child', 'superclasses_changed' ] ],
+    'superclasses_changed'
+);
+is_deeply( events_for { $meta->superclasses }, [],
+    '... but not when only reading them' );
+
+my $immutable = events_for { $meta->make_immutable( inline_constructor => 0 ) };
+is_deeply( $immutable->[-1], [ 'Listen::Child', 'made_immutable' ],
+    'made_immutable' );
+is_deeply( events_for { $meta->make_mutable },
+    [ [ 'Listen::Child', 'made_mutable' ] ], 'made_mutable' );
+
+Class::MOP::remove_metaclass_listener( method_added => $listeners{method_added} );
+is_deeply( events_for { $meta->add_method( baz => sub {1} ) }, [],
+    'remove_metaclass_listener' );
+ok( !exists $Class::MOP::LISTENERS{method_added},
+    '... and an event with no listeners is forgotten' );
+
+{
+    my $calls = 0;
+    my $once;
+    $once = Class::MOP::add_metaclass_listener(
+        method_added => sub {
+            $calls++;
+            Class::MOP::remove_metaclass_listener( method_added => $once );
+        }
+    );
+    $meta->add_method( $_ => sub {1} ) for qw( one two );
+    is( $calls, 1, 'a listener can remove itself' );
+}
+
+throws_ok { Class::MOP::add_metaclass_listener( nonsense => sub {} ) }
+    qr/Unknown metaclass event \(nonsense\)/, 'unknown events are an error';
+throws_ok { Class::MOP::add_metaclass_listener( method_added => 'foo' ) }
+    qr/You must pass a CODE reference as the listener/,
+    'listeners must be code';
+
+done_testing;
@@ -42,4 +42,38 @@ is_deeply([sort Son->meta->direct_subclasses],         []);
 is_deeply([sort Daughter->meta->direct_subclasses],    []);
 is_deeply([sort Cousin->meta->direct_subclasses],      []);
 
+Cousin->meta->superclasses('Parent');
+is_deeply([sort Uncle->meta->direct_subclasses],       [],
+    'superclasses() updates the direct subclasses of the old superclass');
+is_deeply([sort Parent->meta->direct_subclasses],      ['Cousin', 'Daughter', 'Son'],
+    '... and of the new one');
+
+@Son::ISA = ('Uncle');
+is_deeply([sort Parent->meta->direct_subclasses],      ['Cousin', 'Daughter'],
+    'direct_subclasses notices @ISA changes made outside the MOP');
+is_deeply([sort Uncle->meta->direct_subclasses],       ['Son'],
+    '... for the new superclass too');
+
+push @Daughter::ISA, 'Uncle';
+is_deeply([sort Uncle->meta->direct_subclasses],       ['Daughter', 'Son'],
+    'direct_subclasses with multiple inheritance');
+is_deeply([sort Parent->meta->direct_subclasses],      ['Cousin', 'Daughter'],
+    '... for both superclasses');
+
+@Son::ISA = ();
+is_deeply([sort Uncle->meta->direct_subclasses],       ['Daughter'],
+    'classes which no longer inherit are not direct subclasses');
+
+{
+    my $anon = Class::MOP::Class->create_anon_class( superclasses => ['Uncle'] );
+    is_deeply([sort Uncle->meta->direct_subclasses], [sort 'Daughter', $anon->name],
+        'anon classes are direct subclasses');
+}
+is_deeply([sort Uncle->meta->direct_subclasses],       ['Daughter'],
+    '... until they go away');
+
+Class::MOP::remove_metaclass_by_name('Uncle');
+is_deeply([sort Class::MOP::Class->initialize('Uncle')->direct_subclasses], ['Daughter'],
+    'a class whose metaclass was removed and recreated still has its direct subclasses');
+
 done_testing;
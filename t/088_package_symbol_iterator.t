@@ -0,0 +1,161 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+use Class::MOP::Package;
+
+dies_ok { Class::MOP::Package->each_package_symbol(sub { 1 }) } q{... can't call each_package_symbol() as a class method};
+dies_ok { Class::MOP::Package->package_symbol_iterator } q{... can't call package_symbol_iterator() as a class method};
+dies_ok { Class::MOP::Package->get_all_package_symbols_by_type('CODE') } q{... can't call get_all_package_symbols_by_type() as a class method};
+
+{
+    package Foo;
+
+    use constant SOME_CONSTANT => 1;
+
+    our $bar = 1;
+    our @baz = (1, 2);
+    our %quux = (a => 1);
+
+    sub foo { 'Foo::foo' }
+    sub bar { 'Foo::bar' }
+}
+
+my $meta = Class::MOP::Package->initialize('Foo');
+
+{
+    my %symbols;
+    my $iter = $meta->package_symbol_iterator('CODE');
+    isa_ok($iter, 'Class::MOP::Package::SymbolIterator');
+
+    while ( my ($name, $ref) = $iter->next ) {
+        $symbols{$name} = $ref;
+    }
+
+    is_deeply(
+        [ sort keys %symbols ],
+        [ qw(SOME_CONSTANT bar foo) ],
+        '... the iterator found all the CODE symbols'
+    );
+    is($symbols{foo}, \&Foo::foo, '... and returned the right reference');
+    is_deeply([ $iter->next ], [], '... an exhausted iterator stays exhausted');
+
+    is_deeply(
+        $meta->get_all_package_symbols('CODE'),
+        \%symbols,
+        '... same results as get_all_package_symbols'
+    );
+}
+
+{
+    my %symbols;
+    my $iter = $meta->package_symbol_iterator;
+
+    while ( my ($name, $ref) = $iter->next ) {
+        $symbols{$name} = $ref;
+    }
+
+    is_deeply(
+        [ sort keys %symbols ],
+        [ sort keys %{ $meta->get_all_package_symbols } ],
+        '... the unfiltered iterator found all the symbols'
+    );
+}
+
+{
+    my %symbols;
+    $meta->each_package_symbol(sub {
+        my ($name, $ref) = @_;
+        $symbols{$name} = $ref;
+        return 1;
+    }, 'ARRAY');
+
+    is_deeply(\%symbols, { baz => \@Foo::baz }, '... each_package_symbol with a type filter');
+}
+
+{
+    my $seen = 0;
+    $meta->each_package_symbol(sub { $seen++; return 0 }, 'CODE');
+    is($seen, 1, '... each_package_symbol stops when the callback returns false');
+}
+
+{
+    my @names;
+    $meta->each_package_symbol(sub {
+        push @names, $_[0];
+        # looking at the stash from the callback must not disturb us
+        my %all = %{ $meta->get_all_package_symbols('CODE') };
+        return 1;
+    }, 'CODE');
+
+    is_deeply([ sort @names ], [ qw(SOME_CONSTANT bar foo) ], '... callbacks can introspect the package being iterated');
+}
+
+{
+    my $iter = $meta->package_symbol_iterator('HASH');
+    my @first = $iter->next;
+    is($first[0], 'quux', '... got the first HASH symbol');
+
+    my @other = map { $_->next } map { $meta->package_symbol_iterator('HASH') } 1 .. 2;
+    is_deeply([ $iter->next ], [], '... iterators are independent of each other');
+}
+
+{
+    my $symbols = $meta->get_all_package_symbols_by_type(qw(CODE SCALAR ARRAY));
+
+    is_deeply(
+        [ sort keys %$symbols ],
+        [ qw(ARRAY CODE SCALAR) ],
+        '... got one entry per requested type'
+    );
+
+    for my $type (qw(CODE SCALAR ARRAY)) {
+        is_deeply(
+            $symbols->{$type},
+            $meta->get_all_package_symbols($type),
+            "... the $type symbols match get_all_package_symbols"
+        );
+    }
+
+    is_deeply(
+        $meta->get_all_package_symbols_by_type('IO'),
+        { IO => {} },
+        '... requested types with no symbols are still present'
+    );
+
+    throws_ok { $meta->get_all_package_symbols_by_type('GLOB') } qr/Unknown type GLOB/,
+        '... unknown types are rejected';
+    dies_ok { $meta->get_all_package_symbols_by_type } '... at least one type is required';
+}
+
+throws_ok {
+    $meta->each_package_symbol(sub { die "bail out\n" });
+} qr/^bail out/, '... exceptions propagate out of each_package_symbol';
+
+dies_ok { $meta->each_package_symbol('not a coderef') } '... each_package_symbol needs a CODE reference';
+
+ok(!defined(Class::MOP::Package->initialize('No::Such::Package')->package_symbol_iterator),
+   '... no iterator for a package without a stash');
+
+{
+    no strict 'refs';
+    *{"Iter::Many::sub$_"} = sub { } for 1 .. 100;
+
+    my $iter = Class::MOP::Package->initialize('Iter::Many')->package_symbol_iterator('CODE');
+    my %seen;
+    while ( my ($name) = $iter->next ) {
+        $seen{$name}++;
+        # a change to the stash makes the iterator find its place again
+        *{"Iter::Many::late"} = sub { } if $name eq 'sub50';
+    }
+    is( scalar( grep { $seen{"sub$_"} == 1 } 1 .. 100 ), 100,
+        '... every symbol is returned once, even when the stash changes' );
+
+    ok( Class::MOP::Package::SymbolIterator->CLONE_SKIP,
+        '... iterators are not cloned into new threads' );
+}
+
+done_testing;
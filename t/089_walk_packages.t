@@ -0,0 +1,111 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+use Class::MOP::Package;
+
+{
+    package Walk::Root;
+    sub foo { }
+
+    package Walk::Root::Child;
+    our @ISA;
+    our $VERSION = '1.0';
+    sub bar { }
+    sub baz { }
+
+    package Walk::Root::Child::Grandchild;
+    our %hash;
+
+    package Walk::Other;
+    sub quux { }
+
+    package Walk::RootBeer;
+    sub fizz { }
+}
+
+sub walk {
+    my @args = @_;
+    my @names;
+    Class::MOP::Package->walk_packages( sub { push @names, $_[0]; 1 }, @args );
+    return [ sort @names ];
+}
+
+is_deeply(
+    walk( prefix => 'Walk::' ),
+    [ qw(Walk::Other Walk::Root Walk::Root::Child Walk::Root::Child::Grandchild Walk::RootBeer) ],
+    '... found all the packages matching the prefix'
+);
+
+is_deeply(
+    walk( prefix => 'Walk::Root' ),
+    [ qw(Walk::Root Walk::Root::Child Walk::Root::Child::Grandchild) ],
+    '... a prefix only matches whole parts of package names'
+);
+
+is_deeply(
+    walk( root => 'Walk::Root' ),
+    [ qw(Walk::Root Walk::Root::Child Walk::Root::Child::Grandchild) ],
+    '... walking from a given root'
+);
+
+{
+    my @names;
+    Class::MOP::Package->initialize('Walk::Root::Child')
+        ->walk_packages( sub { push @names, $_[0]; 1 } );
+    is_deeply(
+        [ sort @names ],
+        [ qw(Walk::Root::Child Walk::Root::Child::Grandchild) ],
+        '... walking from a metapackage starts at that package'
+    );
+}
+
+{
+    my $everything = walk();
+    ok( ( grep { $_ eq 'main' } @$everything ), '... a full walk includes main' );
+    ok( ( grep { $_ eq 'Class::MOP::Class' } @$everything ), '... and nested packages' );
+    ok( ( grep { $_ eq 'Walk::Root::Child::Grandchild' } @$everything ), '... at any depth' );
+
+    my %seen;
+    ok( !( grep { $seen{$_}++ } @$everything ), '... and sees every package only once' );
+}
+
+{
+    my %summaries;
+    Class::MOP::Package->walk_packages(
+        sub { $summaries{ $_[0] } = $_[1]; 1 },
+        prefix  => 'Walk::Root',
+        summary => 1,
+    );
+
+    is_deeply(
+        $summaries{'Walk::Root::Child'},
+        { CODE => 2, SCALAR => 1, ARRAY => 1, HASH => 0, IO => 0 },
+        '... got the right symbol summary'
+    );
+    is( $summaries{'Walk::Root'}{CODE}, 1, '... nested packages are not counted as symbols' );
+    is( $summaries{'Walk::Root'}{HASH}, 0, '... not even as hashes' );
+}
+
+{
+    my @names;
+    Class::MOP::Package->walk_packages( sub { push @names, $_[0]; return 0 }, prefix => 'Walk::' );
+    is( scalar @names, 1, '... the walk stops when the callback returns false' );
+}
+
+is_deeply( walk( root => 'No::Such::Package' ), [], '... walking a nonexistent package finds nothing' );
+
+{
+    use utf8;
+    eval "package Walk::Ünïcödé; sub foo { } 1" or die $@;
+
+    my ($name) = grep { /^Walk::\x{dc}/ } @{ walk( prefix => 'Walk::' ) };
+    is( $name, 'Walk::Ünïcödé', '... package names keep their UTF-8 flag' );
+}
+
+dies_ok { Class::MOP::Package->walk_packages('foo') } '... a callback is required';
+
+done_testing;
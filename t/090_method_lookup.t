@@ -0,0 +1,241 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+use Scalar::Util 'blessed', 'isweak';
+
+{
+    package Lookup::Exporter;
+    sub imported { }
+
+    package Lookup::Foo;
+    use constant CONST => 42;
+
+    BEGIN { *imported = \&Lookup::Exporter::imported }
+
+    sub foo { }
+    sub bar { }
+    sub stub;
+
+    our $scalar_only = 1;
+}
+
+my $meta = Class::MOP::Class->initialize('Lookup::Foo');
+
+ok( $meta->has_method('foo'), 'has_method finds a method defined in the package' );
+ok( $meta->has_method('CONST'), 'has_method finds constants' );
+ok( $meta->has_method('stub'), 'has_method finds stub declarations' );
+ok( !$meta->has_method('imported'), 'has_method ignores imported subs' );
+ok( !$meta->has_method('scalar_only'), 'has_method ignores globs without a CODE slot' );
+ok( !$meta->has_method('nonexistent'), 'has_method is false for unknown names' );
+
+ok( !exists $meta->_method_map->{bar},
+    'has_method does not create a method object' );
+
+my $foo = $meta->get_method('foo');
+isa_ok( $foo, 'Class::MOP::Method' );
+is( $foo->body, \&Lookup::Foo::foo, '... with the right body' );
+is( $foo->name, 'foo', '... and the right name' );
+is( $foo->package_name, 'Lookup::Foo', '... and the right package' );
+is( $foo->associated_metaclass, $meta, '... and the right metaclass' );
+
+is( $meta->get_method('foo'), $foo, 'get_method returns the cached method object' );
+is( $meta->_method_map->{foo}, $foo, '... which is stored in the method map' );
+
+is( $meta->get_method('imported'), undef, 'get_method ignores imported subs' );
+is( $meta->get_method('nonexistent'), undef, 'get_method returns undef for unknown names' );
+is_deeply( [ $meta->get_method('nonexistent') ], [],
+    '... and an empty list in list context' );
+
+{
+    no warnings 'redefine';
+    *Lookup::Foo::foo = sub { 'new foo' };
+}
+
+my $new_foo = $meta->get_method('foo');
+isnt( $new_foo, $foo, 'get_method rewraps a method whose glob changed' );
+is( $new_foo->body->(), 'new foo', '... with the new body' );
+
+is_deeply(
+    [ sort $meta->get_method_list ],
+    [qw( CONST bar foo stub )],
+    'get_method_list'
+);
+
+for my $name ( undef, '' ) {
+    throws_ok { $meta->get_method($name) } qr/You must define a method name/,
+        'get_method requires a method name';
+    throws_ok { $meta->has_method($name) } qr/You must define a method name/,
+        'has_method requires a method name';
+}
+
+{
+    my $anon = Class::MOP::Class->create_anon_class;
+    ok( !$anon->has_method('foo'), 'has_method on an empty class' );
+    is_deeply( [ $anon->get_method_list ], ['meta'],
+        'get_method_list on an empty class only has the meta method' );
+
+    $anon->add_method( foo => sub { 'foo' } );
+    ok( $anon->has_method('foo'), 'has_method sees methods added with add_method' );
+    ok( blessed $anon->get_method('foo'), '... and get_method wraps them' );
+}
+
+{
+    package Lookup::Full;
+    sub foo { }
+    sub bar { }
+
+    package Lookup::Method;
+    use base 'Class::MOP::Method';
+
+    package Lookup::CustomMethods;
+    sub foo { }
+}
+
+{
+    my $meta = Class::MOP::Class->initialize('Lookup::Full');
+    my $map  = $meta->_full_method_map;
+
+    is_deeply( [ sort keys %$map ], [qw( bar foo )], '_full_method_map has all methods' );
+
+    is( $map->{foo}, \&Lookup::Full::foo,
+        '_full_method_map stores bodies instead of method objects' );
+
+    my $foo = $meta->get_method('foo');
+    is( ref $foo, 'Class::MOP::Method', 'get_method builds a Class::MOP::Method object' );
+    is( $foo->body, \&Lookup::Full::foo, '... with the right body' );
+    is( $foo->name, 'foo', '... and the right name' );
+    is( $foo->package_name, 'Lookup::Full', '... and the right package' );
+    is( $foo->original_method, undef, '... and no original method' );
+    is( $foo->associated_metaclass, $meta, '... and the right metaclass' );
+    ok( isweak( $foo->{associated_metaclass} ), '... which is weakened' );
+    is( $meta->_full_method_map->{foo}, $foo, '... and stores it in the map' );
+    is( $map->{bar}, \&Lookup::Full::bar, '... without wrapping other methods' );
+
+    my $removed = $meta->remove_method('bar');
+    isa_ok( $removed, 'Class::MOP::Method', 'remove_method wraps an unwrapped method' );
+    is( $removed->body, \&Lookup::Full::bar, '... with the right body' );
+    ok( !$meta->has_method('bar'), '... and removes it' );
+}
+
+{
+    my $meta = Class::MOP::Class->create(
+        'Lookup::CustomMethods',
+        method_metaclass => 'Lookup::Method',
+    );
+
+    isa_ok( $meta->get_method('foo'), 'Lookup::Method',
+        'get_method respects a custom method metaclass' );
+}
+
+{
+    package Lookup::Metaclass;
+    use base 'Class::MOP::Class';
+
+    our @wrapped;
+    sub wrap_method_body {
+        my ( $self, %args ) = @_;
+        push @wrapped, $args{name};
+        $self->SUPER::wrap_method_body(%args);
+    }
+
+    package Lookup::CustomWrap;
+    sub foo { }
+}
+
+{
+    my $meta = Lookup::Metaclass->initialize('Lookup::CustomWrap');
+    isa_ok( $meta->get_method('foo'), 'Class::MOP::Method' );
+    is_deeply( \@Lookup::Metaclass::wrapped, ['foo'],
+        'get_method calls an overridden wrap_method_body' );
+}
+
+for my $method (qw( get_method has_method _method_body )) {
+    throws_ok { Class::MOP::Class->$method('foo') }
+        qr/Cannot call $method as a class method/,
+        "$method as a class method is an error";
+}
+for my $method (qw( get_method_list _method_bodies )) {
+    throws_ok { Class::MOP::Class->$method }
+        qr/Cannot call $method as a class method/,
+        "$method as a class method is an error";
+}
+
+{
+    package Lookup::Hiding::Metaclass;
+    use base 'Class::MOP::Class';
+
+    sub get_method {
+        my ( $self, $name ) = @_;
+        return if $name eq 'hidden';
+        $self->SUPER::get_method($name);
+    }
+
+    package Lookup::Hiding;
+    sub hidden  { }
+    sub visible { }
+}
+
+{
+    my $meta = Lookup::Hiding::Metaclass->initialize('Lookup::Hiding');
+    ok( !$meta->has_method('hidden'),
+        'has_method goes through an overridden get_method' );
+    ok( $meta->has_method('visible'), '... and still finds other methods' );
+    is_deeply( [ sort $meta->get_method_list ], ['visible'],
+        '... as does get_method_list' );
+    ok( !defined $meta->_method_body('hidden'), '... and _method_body' );
+    is_deeply( [ keys %{ $meta->_method_bodies } ], ['visible'],
+        '... and _method_bodies' );
+}
+
+{
+    package Lookup::HasHiding::Metaclass;
+    use base 'Class::MOP::Class';
+
+    sub has_method {
+        my ( $self, $name ) = @_;
+        return if $name eq 'hidden';
+        $self->SUPER::has_method($name);
+    }
+
+    package Lookup::HasHiding;
+    sub hidden  { }
+    sub visible { }
+}
+
+{
+    my $meta = Lookup::HasHiding::Metaclass->initialize('Lookup::HasHiding');
+    is_deeply( [ sort $meta->get_method_list ], ['visible'],
+        'get_method_list goes through an overridden has_method' );
+}
+
+{
+    package Lookup::Greedy::Metaclass;
+    use base 'Class::MOP::Class';
+
+    sub _code_is_mine { 1 }
+
+    package Lookup::Greedy;
+    use Scalar::Util 'reftype';
+}
+
+{
+    my $meta = Lookup::Greedy::Metaclass->initialize('Lookup::Greedy');
+    ok( $meta->has_method('reftype'),
+        'an overridden _code_is_mine can claim imported subs' );
+    isa_ok( $meta->get_method('reftype'), 'Class::MOP::Method' );
+    ok( ( grep { $_ eq 'reftype' } $meta->get_method_list ),
+        '... for get_method_list too' );
+}
+
+{
+    my $unblessed = { package => 'Lookup::Greedy' };
+    ok( !Class::MOP::Mixin::HasMethods::has_method( $unblessed, 'reftype' ),
+        'an unblessed hash is looked up without checking for overrides' );
+}
+
+done_testing;
@@ -0,0 +1,87 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+use Scalar::Util 'blessed';
+
+{
+    package Bodies::Exporter;
+    sub imported { }
+
+    package Bodies::Parent;
+    sub foo { 'Parent::foo' }
+    sub bar { 'Parent::bar' }
+
+    package Bodies::Child;
+    our @ISA = ('Bodies::Parent');
+
+    BEGIN { *imported = \&Bodies::Exporter::imported }
+
+    sub foo { 'Child::foo' }
+    sub baz { 'Child::baz' }
+}
+
+my $meta = Class::MOP::Class->initialize('Bodies::Child');
+
+my $bodies = $meta->get_all_method_bodies;
+is_deeply(
+    [ sort keys %$bodies ],
+    [ sort map { $_->name } $meta->get_all_methods ],
+    'get_all_method_bodies finds the same methods as get_all_methods'
+);
+
+is( $bodies->{foo}, \&Bodies::Child::foo, 'overridden methods come from the subclass' );
+is( $bodies->{bar}, \&Bodies::Parent::bar, 'inherited methods come from the parent' );
+is( $bodies->{baz}, \&Bodies::Child::baz, 'new methods come from the subclass' );
+ok( !exists $bodies->{imported}, 'imported subs are not methods' );
+
+is( $meta->find_method_body_by_name('foo'), \&Bodies::Child::foo,
+    'find_method_body_by_name finds the subclass method' );
+is( $meta->find_method_body_by_name('bar'), \&Bodies::Parent::bar,
+    'find_method_body_by_name finds inherited methods' );
+is( $meta->find_method_body_by_name('imported'), undef,
+    'find_method_body_by_name ignores imported subs' );
+is( $meta->find_method_body_by_name('nonexistent'), undef,
+    'find_method_body_by_name returns undef for unknown methods' );
+
+throws_ok { $meta->find_method_body_by_name('') }
+    qr/You must define a method name to find/,
+    'find_method_body_by_name requires a method name';
+
+{
+    package Bodies::Untouched;
+    sub foo { }
+    sub bar { }
+}
+
+{
+    my $meta = Class::MOP::Class->initialize('Bodies::Untouched');
+    $meta->get_all_method_bodies;
+    $meta->find_method_body_by_name('foo');
+
+    ok( !grep( { blessed $_ } values %{ $meta->_full_method_map } ),
+        'looking up bodies does not create method objects' );
+}
+
+{
+    my $class = Class::MOP::Class->create(
+        'Bodies::Immutable',
+        superclasses => ['Bodies::Parent'],
+        methods      => { quux => sub { 'quux' } },
+    );
+    $class->make_immutable;
+
+    my $first = $class->get_all_method_bodies;
+    is( $first->{quux}->(), 'quux', 'get_all_method_bodies on an immutable class' );
+    is( $first->{bar}, \&Bodies::Parent::bar, '... includes inherited methods' );
+
+    delete $first->{quux};
+    ok( exists $class->get_all_method_bodies->{quux},
+        '... and returns a copy of the cached bodies' );
+}
+
+done_testing;
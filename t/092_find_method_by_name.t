@@ -0,0 +1,77 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+use Class::MOP;
+
+{
+    package Find::Exporter;
+    sub helper { 'Exporter::helper' }
+
+    package Find::Grandparent;
+    sub foo    { 'Grandparent::foo' }
+    sub helper { 'Grandparent::helper' }
+
+    package Find::Parent;
+    our @ISA = ('Find::Grandparent');
+    sub bar { 'Parent::bar' }
+
+    package Find::Child;
+    our @ISA = ('Find::Parent');
+
+    BEGIN { *helper = \&Find::Exporter::helper }
+
+    sub foo { 'Child::foo' }
+}
+
+my $meta = Class::MOP::Class->initialize('Find::Child');
+
+is( $meta->_find_method_owner('foo'), 'Find::Child', 'owner of an overridden method' );
+is( $meta->_find_method_owner('bar'), 'Find::Parent', 'owner of an inherited method' );
+is( $meta->_find_method_owner('nonexistent'), '', 'no owner for an unknown method' );
+is( $meta->_find_method_owner('isa'), '', 'UNIVERSAL methods have no owner' );
+is( $meta->_find_method_owner('helper'), undef,
+    'no answer when the method cache finds an imported sub' );
+
+my $foo = $meta->find_method_by_name('foo');
+isa_ok( $foo, 'Class::MOP::Method' );
+is( $foo->body, \&Find::Child::foo, 'find_method_by_name finds the subclass method' );
+is( $foo, $meta->get_method('foo'), '... which is the same object get_method returns' );
+
+is( $meta->find_method_by_name('bar')->body, \&Find::Parent::bar,
+    'find_method_by_name finds inherited methods' );
+is( $meta->find_method_by_name('helper')->body, \&Find::Grandparent::helper,
+    'find_method_by_name skips imported subs' );
+is( $meta->find_method_by_name('nonexistent'), undef,
+    'find_method_by_name returns undef for unknown methods' );
+is( $meta->find_method_by_name('isa'), undef,
+    'find_method_by_name does not find UNIVERSAL methods' );
+
+Class::MOP::Class->initialize('Find::Parent')->add_method( foo => sub { 'Parent::foo' } );
+is( $meta->find_method_by_name('foo')->body, \&Find::Child::foo,
+    'adding a method to a parent does not hide the subclass method' );
+
+$meta->remove_method('foo');
+is( $meta->find_method_by_name('foo')->body->(), 'Parent::foo',
+    'removing a method uses the next one in the hierarchy' );
+
+Class::MOP::Class->initialize('Find::Parent')->superclasses('Find::Exporter');
+is( $meta->find_method_by_name('bar')->body, \&Find::Parent::bar,
+    'changing superclasses keeps methods defined in the class' );
+is( $meta->find_method_by_name('helper')->body, \&Find::Exporter::helper,
+    'imported subs are found in the class which defines them' );
+
+{
+    use utf8;
+    eval 'package Find::Unicode::Parent; sub mëthöd { 1 } package Find::Unicode; our @ISA = ("Find::Unicode::Parent"); 1'
+        or die $@;
+
+    my $unicode = Class::MOP::Class->initialize('Find::Unicode');
+    is( $unicode->_find_method_owner('mëthöd'), 'Find::Unicode::Parent',
+        'owner of a method with a UTF-8 name' );
+    is( $unicode->find_method_by_name('mëthöd')->body, \&Find::Unicode::Parent::mëthöd,
+        '... and find_method_by_name finds it' );
+}
+
+done_testing;
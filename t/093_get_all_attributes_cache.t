@@ -0,0 +1,83 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+use Class::MOP;
+
+sub attr_names {
+    my $meta = shift;
+    return [ sort map { $_->name } $meta->get_all_attributes ];
+}
+
+my $parent = Class::MOP::Class->create(
+    'Cache::Parent',
+    attributes => [ Class::MOP::Attribute->new('foo') ],
+);
+my $child = Class::MOP::Class->create(
+    'Cache::Child',
+    superclasses => ['Cache::Parent'],
+    attributes   => [ Class::MOP::Attribute->new('bar') ],
+);
+my $other = Class::MOP::Class->create(
+    'Cache::Other',
+    attributes => [ Class::MOP::Attribute->new('baz') ],
+);
+
+is_deeply( attr_names($child), [qw( bar foo )], 'inherited attributes' );
+is_deeply( attr_names($child), [qw( bar foo )], '... same result from the cache' );
+
+my @attrs = $child->get_all_attributes;
+pop @attrs;
+is( scalar( () = $child->get_all_attributes ), 2,
+    'changing the returned list does not change the cache' );
+
+$child->add_attribute( Class::MOP::Attribute->new('quux') );
+is_deeply( attr_names($child), [qw( bar foo quux )], 'adding an attribute' );
+
+$parent->add_attribute( Class::MOP::Attribute->new('parent_attr') );
+is_deeply( attr_names($child), [qw( bar foo parent_attr quux )],
+    'adding an attribute to a parent' );
+
+$parent->remove_attribute('parent_attr');
+is_deeply( attr_names($child), [qw( bar foo quux )],
+    'removing an attribute from a parent' );
+
+$child->superclasses('Cache::Other');
+is_deeply( attr_names($child), [qw( bar baz quux )], 'changing superclasses' );
+
+{
+    no warnings 'once';
+    @Cache::Child::ISA = ('Cache::Parent');
+}
+is_deeply( attr_names($child), [qw( bar foo quux )],
+    'changing @ISA directly' );
+
+my $obj = $child->new_object( foo => 1, bar => 2, quux => 3 );
+is_deeply( { %$obj }, { foo => 1, bar => 2, quux => 3 },
+    'construction uses the current attributes' );
+
+$child->add_attribute( Class::MOP::Attribute->new( 'new_attr', init_arg => 'new_attr' ) );
+$obj = $child->new_object( new_attr => 4 );
+is( $obj->{new_attr}, 4, '... even after attributes change' );
+
+{
+    my $base = Class::MOP::Class->create(
+        'Cache::Reinit::Parent',
+        attributes => [ Class::MOP::Attribute->new( 'foo', init_arg => 'foo' ) ],
+    );
+    my $sub = Class::MOP::Class->create(
+        'Cache::Reinit::Child',
+        superclasses => ['Cache::Reinit::Parent'],
+    );
+
+    is_deeply( attr_names($sub), ['foo'], 'attribute from a parent' );
+
+    Class::MOP::Class->reinitialize('Cache::Reinit::Parent');
+    is_deeply( attr_names($sub), [],
+        'reinitializing the parent throws the cache away' );
+    ok( !exists $sub->new_object( foo => 1 )->{foo},
+        '... and construction no longer sets its attributes' );
+}
+
+done_testing;
@@ -0,0 +1,144 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+{
+    package Plan::Foo;
+
+    sub _build_built { 'built' }
+}
+
+my $meta = Class::MOP::Class->create(
+    'Plan::Foo',
+    attributes => [
+        Class::MOP::Attribute->new( 'plain', init_arg => 'plain' ),
+        Class::MOP::Attribute->new(
+            'value_default', init_arg => 'value_default', default => 10,
+        ),
+        Class::MOP::Attribute->new(
+            'code_default',
+            init_arg => 'code_default',
+            default  => sub { ref $_[0] },
+        ),
+        Class::MOP::Attribute->new(
+            'built', init_arg => 'built', builder => '_build_built',
+        ),
+        Class::MOP::Attribute->new( 'no_init_arg', init_arg => undef, default => 1 ),
+        Class::MOP::Attribute->new(
+            'initialized',
+            init_arg    => 'initialized',
+            initializer => sub {
+                my ( $self, $value, $set ) = @_;
+                $set->( $value * 2 );
+            },
+        ),
+    ],
+);
+
+is_deeply(
+    { %{ $meta->new_object } },
+    {
+        value_default => 10,
+        code_default  => 'Plan::Foo',
+        built         => 'built',
+        no_init_arg   => 1,
+    },
+    'defaults and builders'
+);
+
+is_deeply(
+    { %{ $meta->new_object(
+        plain         => 1,
+        value_default => 2,
+        code_default  => 3,
+        built         => 4,
+        no_init_arg   => 5,
+        initialized   => 6,
+    ) } },
+    {
+        plain         => 1,
+        value_default => 2,
+        code_default  => 3,
+        built         => 4,
+        no_init_arg   => 1,
+        initialized   => 12,
+    },
+    'constructor parameters, with an initializer'
+);
+
+my $plan = $meta->_construction_plan( $meta->get_meta_instance );
+is( scalar @$plan, 6, 'one step per attribute' );
+is( $meta->_construction_plan( $meta->get_meta_instance ), $plan,
+    'the plan is reused' );
+
+$meta->add_attribute( Class::MOP::Attribute->new( 'added', default => 'added' ) );
+isnt( $meta->_construction_plan( $meta->get_meta_instance ), $plan,
+    'the plan is rebuilt when attributes change' );
+is( $meta->new_object->{added}, 'added', '... and uses the new attribute' );
+
+{
+    my $bad = Class::MOP::Class->create(
+        'Plan::NoBuilder',
+        attributes => [
+            Class::MOP::Attribute->new( 'foo', builder => '_build_foo' ),
+        ],
+    );
+
+    throws_ok { $bad->new_object }
+        qr/Plan::NoBuilder does not support builder method '_build_foo' for attribute 'foo'/,
+        'missing builders are still an error';
+}
+
+{
+    package Plan::Attribute;
+    use base 'Class::MOP::Attribute';
+
+    sub initialize_instance_slot {
+        my ( $self, $meta_instance, $instance, $params ) = @_;
+        $meta_instance->set_slot_value( $instance, $self->name, 'custom' );
+    }
+
+    package Plan::Instance;
+    use base 'Class::MOP::Instance';
+
+    our @set;
+    sub set_slot_value {
+        my ( $self, $instance, $slot_name, $value ) = @_;
+        push @set, $slot_name;
+        $self->SUPER::set_slot_value( $instance, $slot_name, $value );
+    }
+}
+
+{
+    my $custom = Class::MOP::Class->create(
+        'Plan::Custom',
+        instance_metaclass => 'Plan::Instance',
+        attributes         => [
+            Plan::Attribute->new('custom'),
+            Class::MOP::Attribute->new( 'normal', default => 'normal' ),
+        ],
+    );
+
+    is_deeply(
+        { %{ $custom->new_object } },
+        { custom => 'custom', normal => 'normal' },
+        'attributes which override initialize_instance_slot'
+    );
+    is_deeply( [ sort @Plan::Instance::set ], [qw( custom normal )],
+        'instance metaclasses which override set_slot_value' );
+
+    my $steps = $custom->_construction_plan( $custom->get_meta_instance );
+    is( $custom->_construction_plan( $custom->get_meta_instance ), $steps,
+        'the plan is kept while nothing changes' );
+
+    $custom->invalidate_meta_instance;
+    my $meta_instance = $custom->get_meta_instance;
+    isnt( $custom->_construction_plan($meta_instance), $steps,
+        '... and rebuilt for a new meta instance' );
+}
+
+done_testing;
@@ -0,0 +1,71 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+use Class::MOP;
+
+{
+    package Dependent::Instance;
+    use base 'Class::MOP::Instance';
+
+    sub is_dependent_on_superclasses { 1 }
+}
+
+my $parent = Class::MOP::Class->create(
+    'Dependent::Parent',
+    instance_metaclass => 'Dependent::Instance',
+    attributes         => [ Class::MOP::Attribute->new('foo') ],
+);
+my $child = Class::MOP::Class->create(
+    'Dependent::Child',
+    superclasses       => ['Dependent::Parent'],
+    instance_metaclass => 'Dependent::Instance',
+    attributes         => [ Class::MOP::Attribute->new('bar') ],
+);
+
+sub dependents {
+    my $meta = shift;
+    return [ sort map { $_->name } grep {defined}
+            @{ $meta->{dependent_meta_instances} || [] } ];
+}
+
+my $meta_instance = $child->get_meta_instance;
+is_deeply( dependents($parent), ['Dependent::Child'],
+    'the child depends on the parent' );
+is( ref $parent->{dependent_meta_instances}, 'ARRAY',
+    '... and is kept in a list, as before' );
+
+$parent->add_dependent_meta_instance($child);
+is( scalar @{ $parent->{dependent_meta_instances} }, 1,
+    'adding a dependent twice only records it once' );
+
+$parent->add_attribute( Class::MOP::Attribute->new('baz') );
+isnt( $child->get_meta_instance, $meta_instance,
+    'adding an attribute to the parent invalidates the child meta instance' );
+is_deeply( [ sort $child->get_meta_instance->get_all_slots ], [qw( bar baz foo )],
+    '... which has the new slot' );
+
+$parent->remove_dependent_meta_instance($child);
+is_deeply( dependents($parent), [], 'remove_dependent_meta_instance' );
+
+{
+    my $anon = Class::MOP::Class->create_anon_class(
+        superclasses       => ['Dependent::Parent'],
+        instance_metaclass => 'Dependent::Instance',
+    );
+    $anon->get_meta_instance;
+    $parent->add_dependent_meta_instance($child);
+    is_deeply( dependents($parent), [ sort $anon->name, 'Dependent::Child' ],
+        'anon classes are dependents too' );
+    $parent->remove_dependent_meta_instance($child);
+    is_deeply( dependents($parent), [ $anon->name ],
+        '... and are kept when another dependent is removed' );
+    $parent->add_dependent_meta_instance($child);
+}
+
+$parent->add_attribute( Class::MOP::Attribute->new('quux') );
+is_deeply( [ map { $_->name } @{ $parent->{dependent_meta_instances} } ],
+    ['Dependent::Child'], 'dependents which went away are dropped' );
+
+done_testing;
@@ -0,0 +1,134 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+{
+    package Batch::Meta::Class;
+    use base 'Class::MOP::Class';
+
+    our ( %compat_checks, %invalidations );
+
+    sub _check_metaclass_compatibility {
+        my $self = shift;
+        $compat_checks{ $self->name }++;
+        $self->SUPER::_check_metaclass_compatibility(@_);
+    }
+
+    sub invalidate_meta_instance {
+        my $self = shift;
+        $invalidations{ $self->name }++;
+        $self->SUPER::invalidate_meta_instance(@_);
+    }
+
+    package Batch::Other::Meta::Class;
+    use base 'Class::MOP::Class';
+}
+
+sub reset_counts {
+    %Batch::Meta::Class::compat_checks = ();
+    %Batch::Meta::Class::invalidations = ();
+}
+
+Batch::Meta::Class->create('Batch::Base');
+Batch::Meta::Class->create('Batch::Other');
+reset_counts();
+
+my $result = Class::MOP::batch_define {
+    my $meta = Batch::Meta::Class->create('Batch::Child');
+    $meta->superclasses('Batch::Other');
+    $meta->superclasses('Batch::Base');
+    $meta->add_attribute( Class::MOP::Attribute->new($_) ) for qw( foo bar baz );
+
+    is( $Batch::Meta::Class::compat_checks{'Batch::Child'}, undef,
+        'no compatibility checks inside the block' );
+    is( $Batch::Meta::Class::invalidations{'Batch::Child'}, undef,
+        'no meta instance invalidations inside the block' );
+
+    Class::MOP::batch_define {
+        $meta->add_attribute( Class::MOP::Attribute->new('nested') );
+    };
+    is( $Batch::Meta::Class::invalidations{'Batch::Child'}, undef,
+        'a nested block is part of the outer one' );
+
+    'result';
+};
+
+is( $result, 'result', 'batch_define returns the result of the block' );
+is( $Batch::Meta::Class::compat_checks{'Batch::Child'}, 1,
+    'the compatibility check runs once at the end' );
+is( $Batch::Meta::Class::invalidations{'Batch::Child'}, 1,
+    'the meta instances are invalidated once at the end' );
+is_deeply( [ Batch::Child->meta->superclasses ], ['Batch::Base'],
+    'the superclasses were set' );
+is_deeply(
+    [ sort map { $_->name } Batch::Child->meta->get_all_attributes ],
+    [qw( bar baz foo nested )],
+    'the attributes were added'
+);
+
+reset_counts();
+Class::MOP::batch_define {
+    my $meta = Batch::Child->meta;
+    $meta->get_meta_instance;
+    $meta->add_attribute( Class::MOP::Attribute->new('late') );
+
+    is_deeply(
+        [ sort $meta->get_meta_instance->get_all_slots ],
+        [qw( bar baz foo late nested )],
+        'asking for a meta instance inside the block gets an up to date one'
+    );
+
+    my $obj = $meta->new_object( late => 1 );
+    is( $obj->{late}, 1, '... and objects can be constructed' );
+};
+is( $Batch::Meta::Class::invalidations{'Batch::Child'}, 1,
+    '... without invalidating it again at the end' );
+
+throws_ok {
+    Class::MOP::batch_define {
+        Batch::Other::Meta::Class->create(
+            'Batch::Incompatible',
+            superclasses => ['Batch::Base'],
+        );
+    };
+} qr/compatible/, 'compatibility errors are thrown at the end of the block';
+
+reset_counts();
+my $anon_name;
+throws_ok {
+    Class::MOP::batch_define {
+        Batch::Other::Meta::Class->create(
+            'Batch::Incompatible::Again',
+            superclasses => ['Batch::Base'],
+        );
+        Batch::Child->meta->add_attribute( Class::MOP::Attribute->new('checked') );
+        $anon_name = Class::MOP::Class->create_anon_class->name;
+    };
+} qr/compatible/, 'a check which dies at the end of the block';
+is( $Batch::Meta::Class::invalidations{'Batch::Child'}, 1,
+    '... still lets the queued invalidations run' );
+ok( !Class::MOP::does_metaclass_exist($anon_name),
+    '... and anon classes which went away are still removed' );
+{
+    no strict 'refs';
+    ok( !%{ $anon_name . '::' }, '... along with their packages' );
+}
+
+reset_counts();
+throws_ok {
+    Class::MOP::batch_define {
+        Batch::Child->meta->add_attribute( Class::MOP::Attribute->new('doomed') );
+        Batch::Child->meta->superclasses('Batch::Other');
+        die "oops\n";
+    };
+} qr/^oops$/, 'exceptions from the block are rethrown';
+is( $Batch::Meta::Class::invalidations{'Batch::Child'}, 1,
+    '... after running the queued invalidations' );
+is( $Batch::Meta::Class::compat_checks{'Batch::Child'}, undef,
+    '... but not the queued checks' );
+
+done_testing;
@@ -0,0 +1,95 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+{
+    package Compat::Meta::Class;
+    use base 'Class::MOP::Class';
+
+    our $checks = 0;
+
+    sub _check_metaclass_compatibility_uncached {
+        my $self = shift;
+        $checks++;
+        $self->SUPER::_check_metaclass_compatibility_uncached(@_);
+    }
+
+    package Compat::Meta::Attribute;
+    use base 'Class::MOP::Attribute';
+
+    package Compat::Other::Meta::Attribute;
+    use base 'Class::MOP::Attribute';
+
+    package Compat::Meta::Class::Sub;
+    use base 'Compat::Meta::Class';
+}
+
+Compat::Meta::Class->create(
+    'Compat::Base',
+    attribute_metaclass => 'Compat::Meta::Attribute',
+);
+
+$Compat::Meta::Class::checks = 0;
+for my $n ( 1 .. 3 ) {
+    Compat::Meta::Class->create(
+        "Compat::Child$n",
+        superclasses        => ['Compat::Base'],
+        attribute_metaclass => 'Compat::Meta::Attribute',
+    );
+}
+is( $Compat::Meta::Class::checks, 1,
+    'classes with the same metaclass setup are only checked once' );
+
+Compat::Meta::Class->create(
+    'Compat::Child4',
+    superclasses => ['Compat::Child1'],
+    attribute_metaclass => 'Compat::Meta::Attribute',
+);
+is( $Compat::Meta::Class::checks, 1,
+    '... even when the superclass is different' );
+
+throws_ok {
+    Compat::Meta::Class->create(
+        'Compat::Bad',
+        superclasses        => ['Compat::Base'],
+        attribute_metaclass => 'Compat::Other::Meta::Attribute',
+    );
+} qr/attribute_metaclass/, 'a different setup is still checked';
+
+throws_ok {
+    Compat::Meta::Class->create(
+        'Compat::Bad2',
+        superclasses        => ['Compat::Base'],
+        attribute_metaclass => 'Compat::Other::Meta::Attribute',
+    );
+} qr/attribute_metaclass/, '... and incompatibilities are not cached';
+
+for my $n ( 1 .. 2 ) {
+    my $meta = Compat::Meta::Class->create(
+        "Compat::Fixed$n",
+        superclasses => ['Compat::Base'],
+    );
+    is( $meta->attribute_metaclass, 'Compat::Meta::Attribute',
+        "a setup which needs fixing is fixed every time ($n)" );
+}
+
+for my $n ( 1 .. 2 ) {
+    my $meta = Compat::Meta::Class->create(
+        "Compat::SubBase$n",
+        attribute_metaclass => 'Compat::Meta::Attribute',
+    );
+    Compat::Meta::Class::Sub->create(
+        "Compat::SubChild$n",
+        attribute_metaclass => 'Compat::Meta::Attribute',
+    );
+
+    $meta->superclasses("Compat::SubChild$n");
+    isa_ok( $meta, 'Compat::Meta::Class::Sub',
+        "the class metaclass is fixed every time ($n)" );
+}
+
+done_testing;
@@ -0,0 +1,92 @@
+use strict;
+use warnings;
+
+use Test::More;
+use Test::Exception;
+
+use Class::MOP;
+
+my $idle = Class::MOP::Class->create(
+    'State::Idle',
+    attributes => [
+        Class::MOP::Attribute->new( 'name', init_arg => 'name' ),
+        Class::MOP::Attribute->new( 'hidden', init_arg => undef ),
+    ],
+);
+my $running = Class::MOP::Class->create(
+    'State::Running',
+    superclasses => ['State::Idle'],
+    attributes   => [
+        Class::MOP::Attribute->new(
+            'started', init_arg => 'started', default => 'now',
+        ),
+    ],
+);
+
+my $obj = $idle->new_object( name => 'job' );
+$obj->{hidden} = 'secret';
+
+$running->rebless_instance($obj);
+isa_ok( $obj, 'State::Running' );
+is_deeply( { %$obj }, { name => 'job', hidden => 'secret', started => 'now' },
+    'values are carried over and defaults are set' );
+
+my $reblesser = $running->_reblesser( 'State::Idle', $idle );
+is( $running->_reblesser( 'State::Idle', $idle ), $reblesser,
+    'the reblesser is reused' );
+
+my $other = $idle->new_object( name => 'other' );
+$running->rebless_instance( $other, name => 'renamed', started => 'later' );
+is_deeply( { %$other }, { name => 'renamed', started => 'later' },
+    'parameters override the existing values' );
+
+$running->add_attribute(
+    Class::MOP::Attribute->new( 'progress', default => 0 ) );
+isnt( $running->_reblesser( 'State::Idle', $idle ), $reblesser,
+    'the reblesser is rebuilt when attributes change' );
+
+my $third = $idle->new_object( name => 'third' );
+$running->rebless_instance($third);
+is( $third->{progress}, 0, '... and sets up the new attribute' );
+
+throws_ok { $idle->rebless_instance( $running->new_object ) }
+    qr/You may rebless only into a subclass of \(State::Running\)/,
+    'reblessing into a superclass is still an error';
+
+{
+    package State::Away::Meta;
+    use base 'Class::MOP::Class';
+
+    our @away;
+    sub rebless_instance_away {
+        my ( $self, $instance, $new_meta, %params ) = @_;
+        push @away, [ $self->name, $new_meta->name, \%params ];
+    }
+}
+
+my $away = State::Away::Meta->create('State::Away');
+my $away_to = State::Away::Meta->create(
+    'State::AwayTo',
+    superclasses => ['State::Away'],
+);
+
+$away_to->rebless_instance( $away->new_object, foo => 1 ) for 1 .. 2;
+is_deeply(
+    \@State::Away::Meta::away,
+    [ ( [ 'State::Away', 'State::AwayTo', { foo => 1 } ] ) x 2 ],
+    'rebless_instance_away is called every time'
+);
+
+{
+    my $anon = Class::MOP::Class->create_anon_class(
+        superclasses => ['State::Idle'],
+    );
+    my $sub = Class::MOP::Class->create_anon_class(
+        superclasses => [ $anon->name ],
+    );
+    $sub->rebless_instance( $anon->new_object );
+    ok( exists $sub->{_reblessers}{ $anon->name },
+        'reblessers are kept per class' );
+}
+
+done_testing;
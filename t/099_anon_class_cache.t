@@ -0,0 +1,70 @@
+use strict;
+use warnings;
+
+use Test::More;
+
+use Class::MOP;
+
+{
+    package Anon::Base;
+    sub base_method { 'base' }
+}
+
+sub make_class {
+    my %extra = @_;
+    Class::MOP::Class->create_anon_class(
+        superclasses => ['Anon::Base'],
+        attributes   => [
+            Class::MOP::Attribute->new( 'foo', reader => 'foo', default => 1 ),
+        ],
+        methods => { bar => \&Anon::Base::base_method },
+        cache   => 1,
+        %extra,
+    );
+}
+
+{
+    my $meta = make_class();
+    is( make_class(), $meta, 'the same options give the same class' );
+    is( make_class()->name, $meta->name, '... with the same name' );
+    is( make_class()->new_object->foo, 1, '... which works' );
+
+    isnt( make_class( superclasses => [] ), $meta,
+        'different superclasses give a different class' );
+    isnt(
+        make_class(
+            attributes => [
+                Class::MOP::Attribute->new( 'foo', reader => 'foo', default => 2 ),
+            ],
+        ),
+        $meta,
+        'different attributes give a different class'
+    );
+    isnt( make_class( methods => { bar => sub {'other'} } ), $meta,
+        'different methods give a different class' );
+    isnt( make_class( cache => 0 ), $meta, 'classes are only cached on request' );
+
+    my $plain = Class::MOP::Class->create_anon_class;
+    isnt( Class::MOP::Class->create_anon_class, $plain,
+        'anon classes are not cached by default' );
+
+    my $obj = $meta->new_object;
+    undef $meta;
+    is( ref(make_class()), 'Class::MOP::Class',
+        'a cached class is kept alive by its instances' );
+    is( make_class()->name, ref($obj), '... and is still returned' );
+}
+
+{
+    my $name;
+    {
+        my $meta = make_class( attributes => [] );
+        $name = $meta->name;
+    }
+    ok( !Class::MOP::does_metaclass_exist($name),
+        'the cache does not keep classes alive' );
+    isnt( make_class( attributes => [] )->name, $name,
+        '... and a new class is created next time' );
+}
+
+done_testing;
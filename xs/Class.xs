@@ -0,0 +1,109 @@
+#include "mop.h"
+
+/*
+ * _find_method_owner returns the name of the class which perl's own method
+ * resolution finds $method_name in, an empty string if no class in the
+ * hierarchy has it, or undef if the answer doesn't match what
+ * find_method_by_name would find (because the sub perl found was imported)
+ * and the caller has to walk the hierarchy itself.
+ *
+ * The owner is the package the sub perl found was defined in. It only counts
+ * if that package is in the class's hierarchy, its glob still holds the sub,
+ * and the class itself doesn't have the sub imported. A copy imported into
+ * a superclass in between isn't noticed.
+ */
+
+MODULE = Class::MOP::Class   PACKAGE = Class::MOP::Class
+
+PROTOTYPES: DISABLE
+
+BOOT:
+    INSTALL_SIMPLE_READER_WITH_KEY(Class, generation, generation);
+
+SV *
+_find_method_owner(self, method_name)
+    SV *self
+    SV *method_name
+    PREINIT:
+        HE *package;
+        HV *stash;
+        HV *owner;
+        GV *gv;
+        CV *cv;
+        const char *name;
+        STRLEN len;
+        I32 klen;
+    CODE:
+#if PERL_VERSION < 10
+        PERL_UNUSED_VAR(package);
+        PERL_UNUSED_VAR(stash);
+        PERL_UNUSED_VAR(owner);
+        PERL_UNUSED_VAR(gv);
+        PERL_UNUSED_VAR(cv);
+        PERL_UNUSED_VAR(name);
+        PERL_UNUSED_VAR(len);
+        PERL_UNUSED_VAR(klen);
+        XSRETURN_UNDEF;
+#else
+        package = hv_fetch_ent((HV *)SvRV(self), KEY_FOR(package), 0, HASH_FOR(package));
+        stash   = package && SvOK(HeVAL(package)) ? gv_stashsv(HeVAL(package), 0) : NULL;
+        name    = SvPV_const(method_name, len);
+        klen    = SvUTF8(method_name) ? -(I32)len : (I32)len;
+
+        /* this is answered from (and fills) the stash's method cache */
+#ifdef gv_fetchmeth_pvn
+        gv = stash ? gv_fetchmeth_pvn(stash, name, len, 0, SvUTF8(method_name) ? SVf_UTF8 : 0) : NULL;
+#else
+        gv = stash ? gv_fetchmeth(stash, name, len, 0) : NULL;
+#endif
+        cv = gv ? GvCV(gv) : NULL;
+
+        /* not defined anywhere */
+        if (!cv) {
+            RETVAL = newSVpvs("");
+        }
+        else {
+            SV **owner_gv;
+            GV *origin_gv;
+            SV **own_gv;
+            HEK *owner_name;
+
+            RETVAL = NULL;
+
+            if ( !mop_cv_origin(cv, &origin_gv, &owner) || !origin_gv || !owner ) {
+                XSRETURN_UNDEF;
+            }
+
+            owner_name = HvNAME_HEK(owner);
+            if (!owner_name) {
+                XSRETURN_UNDEF;
+            }
+
+            /* the owner's glob must still hold the sub */
+            owner_gv = hv_fetch(owner, name, klen, 0);
+            if ( !owner_gv || !isGV(*owner_gv) || GvCVu((GV *)*owner_gv) != cv ) {
+                XSRETURN_UNDEF;
+            }
+
+            /* the class has the sub imported, so find_method_by_name looks further */
+            if (owner != stash) {
+                own_gv = hv_fetch(stash, name, klen, 0);
+                if ( own_gv && isGV(*own_gv) && GvCVu((GV *)*own_gv) == cv ) {
+                    XSRETURN_UNDEF;
+                }
+            }
+
+            /* only in UNIVERSAL */
+            if ( strEQ(HEK_KEY(owner_name), "UNIVERSAL") ) {
+                RETVAL = newSVpvs("");
+            }
+            else if ( owner == stash || sv_derived_from(HeVAL(package), HEK_KEY(owner_name)) ) {
+                RETVAL = newSVhek(owner_name);
+            }
+            else {
+                XSRETURN_UNDEF;
+            }
+        }
+#endif
+    OUTPUT:
+        RETVAL
@@ -2,40 +2,67 @@
 
 SV *mop_method_metaclass;
 SV *mop_associated_metaclass;
-SV *mop_wrap;
+SV *mop_wrap_method_body;
 
+/* *Class::MOP::METHOD_INDEX, which holds the method index once it is built */
+static GV *mop_method_index_gv;
+
+/*
+    bless {
+        body                 => $cv,
+        associated_metaclass => $self, # weakened
+        package_name         => $class_name,
+        name                 => $method_name,
+        original_method      => undef,
+    } => 'Class::MOP::Method';
+
+   This is what Class::MOP::Method->wrap does for these arguments, minus the
+   method dispatch and argument processing.
+*/
+static SV *
+mop_new_method_object(pTHX_ SV *const self, SV *const class_name, CV *const cv, SV *const method_name)
+{
+    HV *const method = newHV();
+    SV *const method_object = newRV_noinc((SV *)method);
+    SV *associated_metaclass;
+
+    (void)hv_store_ent(method, KEY_FOR(body), newRV_inc((SV *)cv), HASH_FOR(body));
+
+    associated_metaclass = newSVsv(self);
+    (void)hv_store_ent(method, KEY_FOR(associated_metaclass), associated_metaclass, HASH_FOR(associated_metaclass));
+    sv_rvweaken(associated_metaclass);
+
+    (void)hv_store_ent(method, KEY_FOR(package_name), newSVsv(class_name), HASH_FOR(package_name));
+    (void)hv_store_ent(method, KEY_FOR(name), newSVsv(method_name), HASH_FOR(name));
+    (void)hv_store_ent(method, KEY_FOR(original_method), newSV(0), HASH_FOR(original_method));
+
+    sv_bless(method_object, gv_stashpvs("Class::MOP::Method", GV_ADD));
+
+    return method_object;
+}
+
+/* The map only gets the bare code refs of new or changed methods. Their
+ * method objects are built by get_method, the first time they are asked for. */
 static void
-mop_update_method_map(pTHX_ SV *const self, SV *const class_name, HV *const stash, HV *const map)
+mop_update_method_map(pTHX_ HV *const stash, HV *const map)
 {
     const char *const class_name_pv = HvNAME(stash); /* must be HvNAME(stash), not SvPV_nolen_const(class_name) */
-    SV   *method_metaclass_name;
     char *method_name;
     I32   method_name_len;
     SV   *coderef;
     HV   *symbols;
-    dSP;
 
     symbols = mop_get_all_package_symbols(stash, TYPE_FILTER_CODE);
     sv_2mortal((SV*)symbols);
     (void)hv_iterinit(symbols);
     while ( (coderef = hv_iternextsv(symbols, &method_name, &method_name_len)) ) {
         CV *cv = (CV *)SvRV(coderef);
-        char *cvpkg_name;
-        char *cv_name;
         SV *method_slot;
-        SV *method_object;
 
-        if (!mop_get_code_info(coderef, &cvpkg_name, &cv_name)) {
+        if (!mop_cv_is_from_package(cv, class_name_pv)) {
             continue;
         }
 
-        /* this checks to see that the subroutine is actually from our package  */
-        if ( !(strEQ(cvpkg_name, "constant") && strEQ(cv_name, "__ANON__")) ) {
-            if ( strNE(cvpkg_name, class_name_pv) ) {
-                continue;
-            }
-        }
-
         method_slot = *hv_fetch(map, method_name, method_name_len, TRUE);
         if ( SvOK(method_slot) ) {
             SV *body;
@@ -52,41 +79,294 @@ mop_update_method_map(pTHX_ SV *const self, SV *const class_name, HV *const stas
             }
         }
 
-        method_metaclass_name = mop_call0(aTHX_ self, mop_method_metaclass); /* $self->method_metaclass() */
+        /* $map->{$method_name} = \&cv */
+        sv_setsv(method_slot, coderef);
+    }
+}
 
-        /*
-            $method_object = $method_metaclass->wrap(
-                $cv,
-                associated_metaclass => $self,
-                package_name         => $class_name,
-                name                 => $method_name
-            );
-        */
-        ENTER;
-        SAVETMPS;
-
-        PUSHMARK(SP);
-        EXTEND(SP, 8);
-        PUSHs(method_metaclass_name); /* invocant */
-        mPUSHs(newRV_inc((SV *)cv));
-        PUSHs(mop_associated_metaclass);
-        PUSHs(self);
-        PUSHs(KEY_FOR(package_name));
-        PUSHs(class_name);
-        PUSHs(KEY_FOR(name));
-        mPUSHs(newSVpv(method_name, method_name_len));
-        PUTBACK;
-
-        call_sv(mop_wrap, G_SCALAR | G_METHOD);
-        SPAGAIN;
-        method_object = POPs;
-        PUTBACK;
-        /* $map->{$method_name} = $method_object */
-        sv_setsv(method_slot, method_object);
-
-        FREETMPS;
-        LEAVE;
+/* Class::MOP::_reindex_methods($self), if the method index has been built */
+static void
+mop_reindex_methods(pTHX_ SV *const self)
+{
+    dSP;
+
+    if ( !GvSV(mop_method_index_gv) || !SvTRUE(GvSV(mop_method_index_gv)) ) {
+        return;
+    }
+
+    ENTER;
+    SAVETMPS;
+
+    PUSHMARK(SP);
+    XPUSHs(self);
+    PUTBACK;
+
+    call_pv("Class::MOP::_reindex_methods", G_VOID | G_DISCARD);
+
+    FREETMPS;
+    LEAVE;
+}
+
+/* the metaclass hash behind $self, which must be an object */
+static HV *
+mop_obj_for_self(pTHX_ SV *const self, const char *const method)
+{
+    if ( !SvROK(self) || SvTYPE(SvRV(self)) != SVt_PVHV ) {
+        croak("Cannot call %s as a class method", method);
+    }
+
+    return (HV *)SvRV(self);
+}
+
+static void
+mop_check_method_name(pTHX_ SV *const method_name)
+{
+    if ( !SvOK(method_name) || !sv_len(method_name) ) {
+        croak("You must define a method name");
+    }
+}
+
+/* $self->{methods} ||= {} */
+static HV *
+mop_method_map_for(pTHX_ HV *const obj)
+{
+    SV *const map_ref = HeVAL( hv_fetch_ent(obj, KEY_FOR(methods), TRUE, HASH_FOR(methods)) );
+
+    if ( !SvROK(map_ref) || SvTYPE(SvRV(map_ref)) != SVt_PVHV ) {
+        SV *new_map_ref = newRV_noinc((SV *)newHV());
+        sv_2mortal(new_map_ref);
+        sv_setsv(map_ref, new_map_ref);
+    }
+
+    return (HV *)SvRV(map_ref);
+}
+
+static HV *
+mop_stash_for(pTHX_ HV *const obj)
+{
+    HE *const he = hv_fetch_ent(obj, KEY_FOR(package), 0, HASH_FOR(package));
+    return he && SvOK(HeVAL(he)) ? gv_stashsv(HeVAL(he), 0) : NULL;
+}
+
+/* the CODE slot of the method's glob, read straight from the stash */
+static CV *
+mop_method_body_in_stash(pTHX_ HV *const stash, SV *const method_name)
+{
+    HE *he;
+
+    if (!stash) {
+        return NULL;
+    }
+
+    he = hv_fetch_ent(stash, method_name, 0, 0);
+    if (!he) {
+        return NULL;
+    }
+
+    return (CV *)mop_symbol_for_type(stash, he, TYPE_FILTER_CODE);
+}
+
+static bool
+mop_has_method(pTHX_ HV *const map, HV *const stash, SV *const method_name, CV *const code)
+{
+    HE *const map_he = hv_fetch_ent(map, method_name, 0, 0);
+
+    if ( map_he && SvTRUE(HeVAL(map_he)) ) {
+        return TRUE;
+    }
+
+    return code && mop_cv_is_from_package(code, HvNAME(stash));
+}
+
+/* the body get_method would wrap, found without creating a method object */
+static SV *
+mop_method_body(pTHX_ HV *const map, HV *const stash, SV *const method_name, CV *const code)
+{
+    HE *const map_he = hv_fetch_ent(map, method_name, 0, 0);
+    SV *const map_entry = map_he && SvTRUE(HeVAL(map_he)) ? HeVAL(map_he) : NULL;
+
+    if ( code && (map_entry || mop_cv_is_from_package(code, HvNAME(stash))) ) {
+        return sv_2mortal(newRV_inc((SV *)code));
+    }
+
+    if (!map_entry) {
+        return NULL;
+    }
+
+    if ( sv_isobject(map_entry) ) {
+        return mop_call0(aTHX_ map_entry, KEY_FOR(body)); /* $map_entry->body */
+    }
+
+    return map_entry;
+}
+
+/*
+    $self->wrap_method_body(
+        body                 => $body,
+        name                 => $method_name,
+        associated_metaclass => $self,
+    );
+*/
+static SV *
+mop_call_wrap_method_body(pTHX_ SV *const self, SV *const body, SV *const method_name)
+{
+    SV *method_object;
+    dSP;
+
+    ENTER;
+    SAVETMPS;
+
+    PUSHMARK(SP);
+    EXTEND(SP, 7);
+    PUSHs(self); /* invocant */
+    PUSHs(KEY_FOR(body));
+    PUSHs(body);
+    PUSHs(KEY_FOR(name));
+    PUSHs(method_name);
+    PUSHs(mop_associated_metaclass);
+    PUSHs(self);
+    PUTBACK;
+
+    call_sv(mop_wrap_method_body, G_SCALAR | G_METHOD);
+    SPAGAIN;
+    method_object = newSVsv(POPs);
+    PUTBACK;
+
+    FREETMPS;
+    LEAVE;
+
+    return method_object;
+}
+
+/* true if $self->$method resolves to the one defined in this mixin */
+static bool
+mop_uses_default_method(pTHX_ SV *const self, const char *const method, const char *const default_name)
+{
+    GV *gv;
+
+    if (!sv_isobject(self)) {
+        return TRUE;
     }
+
+    gv = gv_fetchmethod_autoload(SvSTASH(SvRV(self)), method, FALSE);
+
+    return gv && isGV(gv) && GvCV(gv) == get_cv(default_name, 0);
+}
+
+#define MOP_USES_DEFAULT(self, method) \
+    mop_uses_default_method(aTHX_ self, method, "Class::MOP::Mixin::HasMethods::" method)
+
+/* When a subclass overrides get_method or _code_is_mine, the lookups built
+ * on them call them as methods, so they see the override */
+#define MOP_GET_METHOD_IS_OVERRIDDEN(self) \
+    (!MOP_USES_DEFAULT(self, "get_method") || !MOP_USES_DEFAULT(self, "_code_is_mine"))
+
+/* ... and get_method_list goes through has_method too */
+#define MOP_HAS_METHOD_IS_OVERRIDDEN(self) \
+    (MOP_GET_METHOD_IS_OVERRIDDEN(self) || !MOP_USES_DEFAULT(self, "has_method"))
+
+/* $self->_code_is_mine($code), or the same check in C unless it's overridden */
+static bool
+mop_code_is_mine(pTHX_ SV *const self, HV *const stash, CV *const code)
+{
+    bool mine;
+    dSP;
+
+    if ( MOP_USES_DEFAULT(self, "_code_is_mine") ) {
+        return mop_cv_is_from_package(code, HvNAME(stash));
+    }
+
+    ENTER;
+    SAVETMPS;
+
+    PUSHMARK(SP);
+    EXTEND(SP, 2);
+    PUSHs(self);
+    mPUSHs(newRV_inc((SV *)code));
+    PUTBACK;
+
+    call_method("_code_is_mine", G_SCALAR);
+    SPAGAIN;
+    mine = SvTRUE(POPs);
+    PUTBACK;
+
+    FREETMPS;
+    LEAVE;
+
+    return mine;
+}
+
+/* the names in a stash, copied so that Perl code can be called while going
+ * through them */
+static AV *
+mop_stash_names(pTHX_ HV *const stash)
+{
+    AV *const names = (AV *)sv_2mortal((SV *)newAV());
+    HE *he;
+
+    (void)hv_iterinit(stash);
+    while ( (he = hv_iternext(stash)) ) {
+        av_push(names, newSVsv(HeSVKEY_force(he)));
+    }
+
+    return names;
+}
+
+/* $self->$method($method_name) */
+static SV *
+mop_call_with_method_name(pTHX_ SV *const self, const char *const method, SV *const method_name)
+{
+    SV *ret;
+    dSP;
+
+    ENTER;
+    SAVETMPS;
+
+    PUSHMARK(SP);
+    EXTEND(SP, 2);
+    PUSHs(self);
+    PUSHs(method_name);
+    PUTBACK;
+
+    call_method(method, G_SCALAR);
+    SPAGAIN;
+    ret = newSVsv(POPs);
+    PUTBACK;
+
+    FREETMPS;
+    LEAVE;
+
+    return sv_2mortal(ret);
+}
+
+#define mop_call_get_method(self, method_name) \
+    mop_call_with_method_name(aTHX_ self, "get_method", method_name)
+
+/* true unless wrap_method_body or the method metaclass have been customized */
+static bool
+mop_can_build_method_in_c(pTHX_ SV *const self)
+{
+    SV *method_metaclass_name;
+
+    if ( !mop_uses_default_method(aTHX_ self, "wrap_method_body", "Class::MOP::Mixin::HasMethods::wrap_method_body") ) {
+        return FALSE;
+    }
+
+    method_metaclass_name = mop_call0(aTHX_ self, mop_method_metaclass); /* $self->method_metaclass() */
+
+    return SvOK(method_metaclass_name) && !SvROK(method_metaclass_name)
+        && strEQ(SvPV_nolen(method_metaclass_name), "Class::MOP::Method");
+}
+
+static SV *
+mop_wrap_method(pTHX_ SV *const self, SV *const body, SV *const method_name)
+{
+    if ( SvROK(body) && SvTYPE(SvRV(body)) == SVt_PVCV && mop_can_build_method_in_c(aTHX_ self) ) {
+        HE *const he = hv_fetch_ent((HV *)SvRV(self), KEY_FOR(package), 0, HASH_FOR(package));
+        return mop_new_method_object(aTHX_ self, HeVAL(he), (CV *)SvRV(body), method_name);
+    }
+
+    return mop_call_wrap_method_body(aTHX_ self, body, method_name);
 }
 
 MODULE = Class::MOP::Mixin::HasMethods   PACKAGE = Class::MOP::Mixin::HasMethods
@@ -121,13 +401,225 @@ _full_method_map(self)
         }
 
         if ( !SvOK(cache_flag) || SvUV(cache_flag) != current ) {
-            mop_update_method_map(aTHX_ self, class_name, stash, (HV *)SvRV(map_ref));
+            mop_update_method_map(aTHX_ stash, (HV *)SvRV(map_ref));
             sv_setuv(cache_flag, mop_check_package_cache_flag(aTHX_ stash)); /* update_cache_flag() */
+
+            PUTBACK;
+            mop_reindex_methods(aTHX_ self);
+            SPAGAIN;
         }
 
         XPUSHs(map_ref);
 
+SV *
+get_method(self, method_name)
+    SV *self
+    SV *method_name
+    PREINIT:
+        HV *obj;
+        HV *map;
+        HV *stash;
+        HE *map_he;
+        SV *map_entry;
+        CV *code;
+    CODE:
+        obj = mop_obj_for_self(aTHX_ self, "get_method");
+        mop_check_method_name(aTHX_ method_name);
+
+        map       = mop_method_map_for(aTHX_ obj);
+        stash     = mop_stash_for(aTHX_ obj);
+        code      = mop_method_body_in_stash(aTHX_ stash, method_name);
+        map_he    = hv_fetch_ent(map, method_name, 0, 0);
+        map_entry = map_he ? HeVAL(map_he) : NULL;
+
+        if ( map_entry && sv_isobject(map_entry) ) {
+            SV *body;
+
+            /* This seems to happen in some weird cases where methods modifiers
+             * are added via roles or some other such bizareness. Returning the
+             * entry keeps various MX modules from blowing up. */
+            if (!code) {
+                ST(0) = sv_mortalcopy(map_entry);
+                XSRETURN(1);
+            }
+
+            body = mop_call0(aTHX_ map_entry, KEY_FOR(body)); /* $map_entry->body */
+            if ( SvROK(body) && (CV *)SvRV(body) == code ) {
+                ST(0) = sv_mortalcopy(map_entry);
+                XSRETURN(1);
+            }
+        }
+
+        if ( !map_entry || !SvTRUE(map_entry) ) {
+            if ( !code || !mop_code_is_mine(aTHX_ self, stash, code) ) {
+                XSRETURN_EMPTY;
+            }
+        }
+
+        RETVAL = mop_wrap_method(aTHX_
+            self,
+            code ? sv_2mortal(newRV_inc((SV *)code)) : map_entry,
+            method_name
+        );
+
+        /* $self->{methods}{$method_name} = $method_object */
+        (void)hv_store_ent(mop_method_map_for(aTHX_ obj), method_name, newSVsv(RETVAL), 0);
+    OUTPUT:
+        RETVAL
+
+bool
+has_method(self, method_name)
+    SV *self
+    SV *method_name
+    PREINIT:
+        HV *obj;
+        HV *stash;
+    CODE:
+        obj = mop_obj_for_self(aTHX_ self, "has_method");
+        mop_check_method_name(aTHX_ method_name);
+
+        if (MOP_GET_METHOD_IS_OVERRIDDEN(self)) {
+            RETVAL = SvOK(mop_call_get_method(self, method_name));
+        }
+        else {
+            stash  = mop_stash_for(aTHX_ obj);
+            RETVAL = mop_has_method(aTHX_
+                mop_method_map_for(aTHX_ obj),
+                stash,
+                method_name,
+                mop_method_body_in_stash(aTHX_ stash, method_name)
+            );
+        }
+    OUTPUT:
+        RETVAL
+
+void
+get_method_list(self)
+    SV *self
+    PREINIT:
+        HV *obj;
+        HV *map;
+        HV *stash;
+        HE *he;
+    PPCODE:
+        obj   = mop_obj_for_self(aTHX_ self, "get_method_list");
+        map   = mop_method_map_for(aTHX_ obj);
+        stash = mop_stash_for(aTHX_ obj);
+
+        if (!stash) {
+            XSRETURN_EMPTY;
+        }
+
+        if (MOP_HAS_METHOD_IS_OVERRIDDEN(self)) {
+            AV *const names = mop_stash_names(aTHX_ stash);
+            I32 i;
+
+            for (i = 0; i <= av_len(names); i++) {
+                SV *const method_name = *av_fetch(names, i, 0);
+                bool found;
+
+                PUTBACK;
+                found = SvTRUE(mop_call_with_method_name(aTHX_ self, "has_method", method_name));
+                SPAGAIN;
+
+                if (found) {
+                    XPUSHs(method_name);
+                }
+            }
+            PUTBACK;
+            return;
+        }
+
+        (void)hv_iterinit(stash);
+        while ( (he = hv_iternext(stash)) ) {
+            SV *const method_name = HeSVKEY_force(he);
+            CV *const code        = (CV *)mop_symbol_for_type(stash, he, TYPE_FILTER_CODE);
+
+            if ( mop_has_method(aTHX_ map, stash, method_name, code) ) {
+                XPUSHs(method_name);
+            }
+        }
+
+void
+_method_body(self, method_name)
+    SV *self
+    SV *method_name
+    PREINIT:
+        HV *obj;
+        HV *stash;
+        SV *body;
+    CODE:
+        obj = mop_obj_for_self(aTHX_ self, "_method_body");
+        mop_check_method_name(aTHX_ method_name);
+
+        if (MOP_GET_METHOD_IS_OVERRIDDEN(self)) {
+            SV *const method = mop_call_get_method(self, method_name);
+            body = SvOK(method) ? mop_call0(aTHX_ method, KEY_FOR(body)) : NULL; /* $method->body */
+        }
+        else {
+            stash = mop_stash_for(aTHX_ obj);
+            body  = mop_method_body(aTHX_
+                mop_method_map_for(aTHX_ obj),
+                stash,
+                method_name,
+                mop_method_body_in_stash(aTHX_ stash, method_name)
+            );
+        }
+
+        if (!body) {
+            XSRETURN_EMPTY;
+        }
+
+        ST(0) = sv_mortalcopy(body);
+        XSRETURN(1);
+
+SV *
+_method_bodies(self)
+    SV *self
+    PREINIT:
+        HV *obj;
+        HV *map;
+        HV *stash;
+        HV *bodies;
+        HE *he;
+    CODE:
+        obj    = mop_obj_for_self(aTHX_ self, "_method_bodies");
+        map    = mop_method_map_for(aTHX_ obj);
+        stash  = mop_stash_for(aTHX_ obj);
+        bodies = newHV();
+        RETVAL = newRV_noinc((SV *)bodies);
+
+        if (stash && MOP_GET_METHOD_IS_OVERRIDDEN(self)) {
+            AV *const names = mop_stash_names(aTHX_ stash);
+            I32 i;
+
+            for (i = 0; i <= av_len(names); i++) {
+                SV *const method_name = *av_fetch(names, i, 0);
+                SV *const method      = mop_call_get_method(self, method_name);
+
+                if (SvOK(method)) {
+                    SV *const body = mop_call0(aTHX_ method, KEY_FOR(body)); /* $method->body */
+                    (void)hv_store_ent(bodies, method_name, newSVsv(body), 0);
+                }
+            }
+        }
+        else if (stash) {
+            (void)hv_iterinit(stash);
+            while ( (he = hv_iternext(stash)) ) {
+                SV *const method_name = HeSVKEY_force(he);
+                CV *const code        = (CV *)mop_symbol_for_type(stash, he, TYPE_FILTER_CODE);
+                SV *const body        = mop_method_body(aTHX_ map, stash, method_name, code);
+
+                if (body) {
+                    (void)hv_store_ent(bodies, method_name, newSVsv(body), 0);
+                }
+            }
+        }
+    OUTPUT:
+        RETVAL
+
 BOOT:
     mop_method_metaclass     = newSVpvs("method_metaclass");
     mop_associated_metaclass = newSVpvs("associated_metaclass");
-    mop_wrap                 = newSVpvs("wrap");
+    mop_wrap_method_body     = newSVpvs("wrap_method_body");
+    mop_method_index_gv      = gv_fetchpvs("Class::MOP::METHOD_INDEX", GV_ADD, SVt_PV);
@@ -1,11 +1,12 @@
 #include "mop.h"
 
 static bool
-find_method (const char *key, STRLEN keylen, SV *val, void *ud)
+find_method (const char *key, STRLEN keylen, type_filter_t type, SV *val, void *ud)
 {
     bool *found_method = (bool *)ud;
     PERL_UNUSED_ARG(key);
     PERL_UNUSED_ARG(keylen);
+    PERL_UNUSED_ARG(type);
     PERL_UNUSED_ARG(val);
     *found_method = TRUE;
     return FALSE;
@@ -44,6 +45,7 @@ EXTERN_C XS(boot_Class__MOP__Mixin__HasMethods);
 EXTERN_C XS(boot_Class__MOP__Package);
 EXTERN_C XS(boot_Class__MOP__Mixin__AttributeCore);
 EXTERN_C XS(boot_Class__MOP__Method);
+EXTERN_C XS(boot_Class__MOP__Class);
 
 MODULE = Class::MOP   PACKAGE = Class::MOP
 
@@ -56,6 +58,7 @@ BOOT:
     MOP_CALL_BOOT (boot_Class__MOP__Package);
     MOP_CALL_BOOT (boot_Class__MOP__Mixin__AttributeCore);
     MOP_CALL_BOOT (boot_Class__MOP__Method);
+    MOP_CALL_BOOT (boot_Class__MOP__Class);
 
 # use prototype here to be compatible with get_code_info from Sub::Identify
 void
@@ -63,14 +66,42 @@ get_code_info(coderef)
     SV *coderef
     PROTOTYPE: $
     PREINIT:
-        char *pkg  = NULL;
-        char *name = NULL;
+        SV *pkg  = NULL;
+        SV *name = NULL;
     PPCODE:
         SvGETMAGIC(coderef);
-        if (mop_get_code_info(coderef, &pkg, &name)) {
+        if (mop_get_code_info_sv(coderef, &pkg, &name)) {
             EXTEND(SP, 2);
-            mPUSHs(newSVpv(pkg, 0));
-            mPUSHs(newSVpv(name, 0));
+            mPUSHs(pkg);
+            mPUSHs(name);
+        }
+
+void
+get_code_info_list(coderefs)
+    AV *coderefs
+    PREINIT:
+        I32 i;
+        I32 len;
+    PPCODE:
+        len = av_len(coderefs) + 1;
+        EXTEND(SP, 2 * len);
+        for (i = 0; i < len; i++) {
+            SV **coderef = av_fetch(coderefs, i, 0);
+            SV *pkg;
+            SV *name;
+
+            if (coderef) {
+                SvGETMAGIC(*coderef);
+            }
+
+            if (coderef && mop_get_code_info_sv(*coderef, &pkg, &name)) {
+                mPUSHs(pkg);
+                mPUSHs(name);
+            }
+            else {
+                PUSHs(&PL_sv_undef);
+                PUSHs(&PL_sv_undef);
+            }
         }
 
 void
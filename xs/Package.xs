@@ -1,5 +1,191 @@
 #include "mop.h"
 
+static bool
+call_symbol_callback (const char *key, STRLEN keylen, type_filter_t type, SV *val, void *ud)
+{
+    SV *callback = (SV *)ud;
+    bool ret;
+
+    dSP;
+    PERL_UNUSED_ARG(type);
+
+    ENTER;
+    SAVETMPS;
+    PUSHMARK(SP);
+    EXTEND(SP, 2);
+    mPUSHs(newSVpvn(key, keylen));
+    mPUSHs(newRV_inc(val));
+    PUTBACK;
+
+    call_sv(callback, G_SCALAR);
+
+    SPAGAIN;
+    ret = SvTRUE(POPs);
+    PUTBACK;
+
+    FREETMPS;
+    LEAVE;
+
+    return ret;
+}
+
+static bool
+fetch_symbol (const char *key, STRLEN keylen, type_filter_t type, SV *val, void *ud)
+{
+    SV **symbol = (SV **)ud;
+    PERL_UNUSED_ARG(type);
+
+    symbol[0] = newSVpvn(key, keylen);
+    symbol[1] = newRV_inc(val);
+
+    return TRUE;
+}
+
+static void
+free_symbol_iter (pTHX_ void *iter)
+{
+    mop_symbol_iter_free((mop_symbol_iter_t *)iter);
+}
+
+static HV *
+stash_for_self (pTHX_ SV *self, const char *method)
+{
+    HE *he;
+
+    if ( ! SvROK(self) ) {
+        die("Cannot call %s as a class method", method);
+    }
+
+    if ( (he = hv_fetch_ent((HV *)SvRV(self), KEY_FOR(package), 0, HASH_FOR(package))) ) {
+        return gv_stashsv(HeVAL(he), 0);
+    }
+
+    return NULL;
+}
+
+#define ENDS_WITH_COLONS(key, keylen) \
+    ((keylen) > 2 && (key)[(keylen) - 2] == ':' && (key)[(keylen) - 1] == ':')
+
+static bool
+collect_child_stashes (const char *key, STRLEN keylen, type_filter_t type, SV *val, void *ud)
+{
+    AV *children = (AV *)ud;
+    const char *name;
+    PERL_UNUSED_ARG(type);
+
+    if (!ENDS_WITH_COLONS(key, keylen) || SvTYPE(val) != SVt_PVHV) {
+        return TRUE;
+    }
+
+    if ( (name = HvNAME((HV *)val)) ) {
+        av_push(children, newRV_inc(val));
+    }
+
+    return TRUE;
+}
+
+static bool
+count_symbols (const char *key, STRLEN keylen, type_filter_t type, SV *val, void *ud)
+{
+    IV *counts = (IV *)ud;
+    int i;
+    PERL_UNUSED_ARG(val);
+
+    /* nested packages aren't symbols of this one */
+    if (ENDS_WITH_COLONS(key, keylen)) {
+        return TRUE;
+    }
+
+    for (i = 0; i < TYPE_FILTER_COUNT; i++) {
+        if (type == (type_filter_t)(1 << i)) {
+            counts[i]++;
+        }
+    }
+
+    return TRUE;
+}
+
+static HV *
+summarize_package (HV *stash)
+{
+    HV *summary = newHV();
+    IV counts[TYPE_FILTER_COUNT] = { 0 };
+    int i;
+
+    mop_get_package_symbols(stash, TYPE_FILTER_CODE | TYPE_FILTER_ARRAY | TYPE_FILTER_IO | TYPE_FILTER_HASH | TYPE_FILTER_SCALAR, count_symbols, counts);
+
+    for (i = 0; i < TYPE_FILTER_COUNT; i++) {
+        const char *type_name = mop_type_filter_name((type_filter_t)(1 << i));
+        (void)hv_store(summary, type_name, strlen(type_name), newSViv(counts[i]), 0);
+    }
+
+    return summary;
+}
+
+/* is one of name and prefix a prefix of the other? */
+static bool
+could_contain_prefix (const char *name, const char *prefix, STRLEN prefix_len)
+{
+    STRLEN name_len = strlen(name);
+    return memEQ(name, prefix, name_len < prefix_len ? name_len : prefix_len);
+}
+
+/* is the package the prefix itself, or nested in it? The prefix only matches
+ * whole parts of the name, so Foo matches Foo::Bar but not FooBar. A prefix
+ * which ends in :: only matches packages nested in it. */
+static bool
+matches_prefix (const char *name, const char *prefix, STRLEN prefix_len)
+{
+    STRLEN name_len = strlen(name);
+
+    if (name_len < prefix_len || !memEQ(name, prefix, prefix_len)) {
+        return FALSE;
+    }
+
+    return name_len == prefix_len
+        || ENDS_WITH_COLONS(prefix, prefix_len)
+        || (name_len > prefix_len + 1 && name[prefix_len] == ':' && name[prefix_len + 1] == ':');
+}
+
+/* the package's name, keeping its UTF-8 flag */
+static SV *
+package_name_sv (pTHX_ HV *stash)
+{
+#ifdef HvNAME_HEK
+    return newSVhek(HvNAME_HEK(stash));
+#else
+    return newSVpv(HvNAME(stash), 0);
+#endif
+}
+
+static bool
+call_package_callback (pTHX_ SV *callback, HV *stash, bool want_summary)
+{
+    bool ret;
+
+    dSP;
+    ENTER;
+    SAVETMPS;
+    PUSHMARK(SP);
+    EXTEND(SP, 2);
+    mPUSHs(package_name_sv(aTHX_ stash));
+    if (want_summary) {
+        mPUSHs(newRV_noinc((SV *)summarize_package(stash)));
+    }
+    PUTBACK;
+
+    call_sv(callback, G_SCALAR);
+
+    SPAGAIN;
+    ret = SvTRUE(POPs);
+    PUTBACK;
+
+    FREETMPS;
+    LEAVE;
+
+    return ret;
+}
+
 MODULE = Class::MOP::Package   PACKAGE = Class::MOP::Package
 
 PROTOTYPES: DISABLE
@@ -35,5 +221,186 @@ get_all_package_symbols(self, filter=TYPE_FILTER_NONE)
         symbols = mop_get_all_package_symbols(stash, filter);
         PUSHs(sv_2mortal(newRV_noinc((SV *)symbols)));
 
+void
+get_all_package_symbols_by_type(self, ...)
+    SV *self
+    PREINIT:
+        HV *stash;
+        type_filter_t filter = TYPE_FILTER_NONE;
+        HV *symbols;
+        int i;
+    PPCODE:
+        stash = stash_for_self(aTHX_ self, "get_all_package_symbols_by_type");
+
+        if (items < 2) {
+            croak("You must pass at least one type to get_all_package_symbols_by_type");
+        }
+
+        for (i = 1; i < items; i++) {
+            filter |= mop_type_filter_for_name(SvPV_nolen(ST(i)));
+        }
+
+        if (GIMME_V == G_VOID) {
+            XSRETURN_EMPTY;
+        }
+
+        if (!stash) {
+            XSRETURN_UNDEF;
+        }
+
+        symbols = mop_get_all_package_symbols_by_type(stash, filter);
+        mPUSHs(newRV_noinc((SV *)symbols));
+
+void
+_walk_packages(root, prefix, want_summary, callback)
+    SV *root
+    SV *prefix
+    bool want_summary
+    SV *callback
+    PREINIT:
+        HV *root_stash;
+        HV *seen;
+        AV *pending;
+        const char *prefix_pv = NULL;
+        STRLEN prefix_len = 0;
+        bool done = FALSE;
+    PPCODE:
+        if ( !(root_stash = gv_stashsv(root, 0)) ) {
+            XSRETURN_EMPTY;
+        }
+
+        if (SvOK(prefix)) {
+            prefix_pv = SvPV_const(prefix, prefix_len);
+        }
+
+        /* this is done depth first with an explicit stack of stashes still to
+         * be visited, and a set of the ones already seen, because every stash
+         * can be reached from %main:: (including %main:: itself) */
+        seen    = (HV *)sv_2mortal((SV *)newHV());
+        pending = (AV *)sv_2mortal((SV *)newAV());
+
+        av_push(pending, newRV_inc((SV *)root_stash));
+
+        /* every iteration gets its own temps scope, so the children and
+         * stash refs of a stash are freed once it has been visited rather
+         * than when the whole walk is done */
+        while (!done && av_len(pending) != -1) {
+            SV *stash_ref;
+            HV *stash;
+            const char *name;
+
+            ENTER;
+            SAVETMPS;
+
+            stash_ref = sv_2mortal(av_pop(pending));
+            stash     = (HV *)SvRV(stash_ref);
+            name      = HvNAME(stash);
+
+            if (!hv_exists(seen, (char *)&stash, sizeof(stash))) {
+                (void)hv_store(seen, (char *)&stash, sizeof(stash), SvREFCNT_inc(&PL_sv_yes), 0);
+
+                if (stash == root_stash || !prefix_pv || could_contain_prefix(name, prefix_pv, prefix_len)) {
+                    if ((!prefix_pv || matches_prefix(name, prefix_pv, prefix_len))
+                     && !call_package_callback(aTHX_ callback, stash, want_summary)) {
+                        done = TRUE;
+                    }
+                    else {
+                        AV *children = (AV *)sv_2mortal((SV *)newAV());
+                        I32 i;
+
+                        mop_get_package_symbols(stash, TYPE_FILTER_HASH, collect_child_stashes, children);
+
+                        /* push in reverse so they are visited in the order they were found */
+                        for (i = av_len(children); i >= 0; i--) {
+                            SV **child = av_fetch(children, i, 0);
+                            av_push(pending, SvREFCNT_inc(*child));
+                        }
+                    }
+                }
+            }
+
+            FREETMPS;
+            LEAVE;
+        }
+
+        XSRETURN_EMPTY;
+
+void
+each_package_symbol(self, callback, filter=TYPE_FILTER_NONE)
+    SV *self
+    SV *callback
+    type_filter_t filter
+    PREINIT:
+        HV *stash;
+        mop_symbol_iter_t iter;
+    PPCODE:
+        stash = stash_for_self(aTHX_ self, "each_package_symbol");
+
+        if (!SvROK(callback) || SvTYPE(SvRV(callback)) != SVt_PVCV) {
+            croak("You must pass a CODE reference to each_package_symbol");
+        }
+
+        if (!stash) {
+            XSRETURN_EMPTY;
+        }
+
+        ENTER;
+        mop_symbol_iter_init(&iter, stash, filter);
+        SAVEDESTRUCTOR_X(free_symbol_iter, &iter);
+
+        while (mop_symbol_iter_next(&iter, call_symbol_callback, callback));
+
+        LEAVE;
+        XSRETURN_EMPTY;
+
+void
+package_symbol_iterator(self, filter=TYPE_FILTER_NONE)
+    SV *self
+    type_filter_t filter
+    PREINIT:
+        HV *stash;
+        mop_symbol_iter_t *iter;
+    PPCODE:
+        stash = stash_for_self(aTHX_ self, "package_symbol_iterator");
+
+        if (!stash) {
+            XSRETURN_UNDEF;
+        }
+
+        Newx(iter, 1, mop_symbol_iter_t);
+        mop_symbol_iter_init(iter, stash, filter);
+
+        mPUSHs(sv_setref_pv(newSV(0), "Class::MOP::Package::SymbolIterator", (void *)iter));
+
 BOOT:
     INSTALL_SIMPLE_READER_WITH_KEY(Package, name, package);
+
+MODULE = Class::MOP::Package   PACKAGE = Class::MOP::Package::SymbolIterator
+
+PROTOTYPES: DISABLE
+
+void
+next(iter)
+    mop_symbol_iter_t *iter
+    PREINIT:
+        SV *symbol[2];
+    PPCODE:
+        if (mop_symbol_iter_next(iter, fetch_symbol, symbol)) {
+            EXTEND(SP, 2);
+            mPUSHs(symbol[0]);
+            mPUSHs(symbol[1]);
+        }
+
+int
+CLONE_SKIP(...)
+    CODE:
+        RETVAL = 1;
+    OUTPUT:
+        RETVAL
+
+void
+DESTROY(iter)
+    mop_symbol_iter_t *iter
+    CODE:
+        mop_symbol_iter_free(iter);
+        Safefree(iter);